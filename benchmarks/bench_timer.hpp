@@ -0,0 +1,105 @@
+#ifndef ESTL_BENCH_TIMER_HPP
+#define ESTL_BENCH_TIMER_HPP
+
+#include <stdint.h>
+#include <estl/config.hpp>
+
+/**
+ * @file bench_timer.hpp
+ * @brief Cycle counter backends for the benchmarks
+ *
+ * - Cortex-M3/M4/M7/M33: DWT->CYCCNT, exact core cycles
+ * - x86 hosts: the time stamp counter (reference cycles)
+ * - anything else: std::chrono::steady_clock in nanoseconds
+ *
+ * Define ESTL_BENCH_TIMER_CHRONO to force the portable backend.
+ */
+
+#if !defined(ESTL_BENCH_TIMER_CHRONO) && defined(ESTL_PLATFORM_ARM) && \
+    (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__))
+    #define ESTL_BENCH_TIMER_DWT
+#elif !defined(ESTL_BENCH_TIMER_CHRONO) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define ESTL_BENCH_TIMER_TSC
+    #include <x86intrin.h>
+#else
+    #ifndef ESTL_BENCH_TIMER_CHRONO
+        #define ESTL_BENCH_TIMER_CHRONO
+    #endif
+    #include <chrono>
+#endif
+
+namespace bench {
+
+#if defined(ESTL_BENCH_TIMER_DWT)
+
+// Debug Exception and Monitor Control and Data Watchpoint registers
+#define ESTL_BENCH_DEMCR      (*reinterpret_cast<volatile uint32_t*>(0xE000EDFCu))
+#define ESTL_BENCH_DWT_CTRL   (*reinterpret_cast<volatile uint32_t*>(0xE0001000u))
+#define ESTL_BENCH_DWT_CYCCNT (*reinterpret_cast<volatile uint32_t*>(0xE0001004u))
+#define ESTL_BENCH_DWT_LAR    (*reinterpret_cast<volatile uint32_t*>(0xE0001FB0u))
+
+inline void timer_init() {
+    ESTL_BENCH_DEMCR |= (1u << 24);       // TRCENA
+    ESTL_BENCH_DWT_LAR = 0xC5ACCE55u;     // unlock on parts with a lock (M7)
+    ESTL_BENCH_DWT_CYCCNT = 0;
+    ESTL_BENCH_DWT_CTRL |= 1u;            // CYCCNTENA
+}
+
+// 32-bit counter; differences stay correct across one wrap
+inline uint64_t timer_now() {
+    return ESTL_BENCH_DWT_CYCCNT;
+}
+
+inline uint64_t timer_elapsed(uint64_t start, uint64_t stop) {
+    return static_cast<uint32_t>(static_cast<uint32_t>(stop) - static_cast<uint32_t>(start));
+}
+
+inline const char* timer_unit() {
+    return "cycles";
+}
+
+#elif defined(ESTL_BENCH_TIMER_TSC)
+
+inline void timer_init() {}
+
+inline uint64_t timer_now() {
+    return __rdtsc();
+}
+
+inline uint64_t timer_elapsed(uint64_t start, uint64_t stop) {
+    return stop - start;
+}
+
+inline const char* timer_unit() {
+    return "tsc";
+}
+
+#else
+
+inline void timer_init() {}
+
+inline uint64_t timer_now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline uint64_t timer_elapsed(uint64_t start, uint64_t stop) {
+    return stop - start;
+}
+
+inline const char* timer_unit() {
+    return "ns";
+}
+
+#endif
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    __asm__ __volatile__("" : : "g"(&value) : "memory");
+}
+
+} // namespace bench
+
+#endif // ESTL_BENCH_TIMER_HPP
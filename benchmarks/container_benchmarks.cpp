@@ -0,0 +1,700 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <estl.hpp>
+#include "bench_timer.hpp"
+
+// Benchmarks for the estl containers and algorithms. On hosts each case is
+// paired with its std equivalent; bare-metal builds only time estl.
+//
+// Every case is run several times and the fastest run is reported as time
+// per operation, which keeps interrupts and cache warm-up out of the result.
+
+#ifndef ESTL_BENCH_WITH_STD
+    #if defined(ESTL_BENCH_TIMER_DWT)
+        #define ESTL_BENCH_WITH_STD 0
+    #else
+        #define ESTL_BENCH_WITH_STD 1
+    #endif
+#endif
+
+#if ESTL_BENCH_WITH_STD
+    #include <algorithm>
+    #include <map>
+    #include <unordered_map>
+    #include <vector>
+#endif
+
+namespace {
+
+const int kRepeats = 7;
+const size_t kSortSize = 2048;
+const size_t kShiftSize = 256;
+
+// Deterministic pseudo-random keys (no <random> on small targets)
+uint32_t g_seed = 12345u;
+
+uint32_t next_random() {
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return g_seed >> 8;
+}
+
+uint32_t g_keys[kSortSize];
+uint32_t g_work[kSortSize];
+
+void fill_keys(size_t count) {
+    g_seed = 12345u;
+    for (size_t i = 0; i < count; ++i) {
+        g_keys[i] = next_random();
+    }
+}
+
+// Best-of-kRepeats time per operation; setup runs untimed before each pass
+template <typename Setup, typename Run>
+double measure(size_t ops, Setup setup, Run run) {
+    uint64_t best = ~static_cast<uint64_t>(0);
+    for (int r = 0; r < kRepeats; ++r) {
+        setup();
+        uint64_t start = bench::timer_now();
+        run();
+        uint64_t elapsed = bench::timer_elapsed(start, bench::timer_now());
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return static_cast<double>(best) / static_cast<double>(ops);
+}
+
+void no_setup() {}
+
+void print_header() {
+    printf("%-36s %14s %14s\n", "benchmark", "estl", "std");
+}
+
+void print_row(const char* name, double estl_time, double std_time) {
+    if (std_time < 0.0) {
+        printf("%-36s %14.1f %14s\n", name, estl_time, "-");
+    } else {
+        printf("%-36s %14.1f %14.1f\n", name, estl_time, std_time);
+    }
+}
+
+void print_row(const char* name, size_t capacity, double estl_time, double std_time) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s <%u>", name, static_cast<unsigned>(capacity));
+    print_row(label, estl_time, std_time);
+}
+
+// vector
+estl::vector<uint32_t, kSortSize> g_vector;
+
+void bench_vector() {
+    double estl_time = measure(kSortSize,
+        [] { g_vector.clear(); },
+        [] {
+            for (size_t i = 0; i < kSortSize; ++i) {
+                g_vector.push_back(g_keys[i]);
+            }
+            bench::do_not_optimize(g_vector);
+        });
+    double std_time = -1.0;
+#if ESTL_BENCH_WITH_STD
+    std::vector<uint32_t> reference;
+    reference.reserve(kSortSize);
+    std_time = measure(kSortSize,
+        [&] { reference.clear(); },
+        [&] {
+            for (size_t i = 0; i < kSortSize; ++i) {
+                reference.push_back(g_keys[i]);
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("vector push_back", estl_time, std_time);
+
+    estl_time = measure(kShiftSize,
+        [] { g_vector.assign(g_keys, g_keys + kShiftSize); },
+        [] {
+            for (size_t i = 0; i < kShiftSize; ++i) {
+                g_vector.insert(g_vector.begin(), g_keys[i]);
+            }
+            bench::do_not_optimize(g_vector);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kShiftSize,
+        [&] { reference.assign(g_keys, g_keys + kShiftSize); },
+        [&] {
+            for (size_t i = 0; i < kShiftSize; ++i) {
+                reference.insert(reference.begin(), g_keys[i]);
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("vector insert front", estl_time, std_time);
+
+    estl_time = measure(kShiftSize,
+        [] { g_vector.assign(g_keys, g_keys + 2 * kShiftSize); },
+        [] {
+            for (size_t i = 0; i < kShiftSize; ++i) {
+                g_vector.erase(g_vector.begin());
+            }
+            bench::do_not_optimize(g_vector);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kShiftSize,
+        [&] { reference.assign(g_keys, g_keys + 2 * kShiftSize); },
+        [&] {
+            for (size_t i = 0; i < kShiftSize; ++i) {
+                reference.erase(reference.begin());
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("vector erase front", estl_time, std_time);
+}
+
+// map and unordered_map
+template <size_t Capacity>
+void bench_map() {
+    static estl::map<uint32_t, uint32_t, estl::less<uint32_t>, Capacity> table;
+
+    double estl_time = measure(Capacity,
+        [] { table.clear(); },
+        [] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+            bench::do_not_optimize(table);
+        });
+    double std_time = -1.0;
+#if ESTL_BENCH_WITH_STD
+    std::map<uint32_t, uint32_t> reference;
+    std_time = measure(Capacity,
+        [&] { reference.clear(); },
+        [&] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("map insert", Capacity, estl_time, std_time);
+
+    static std::pair<uint32_t, uint32_t> items[Capacity];
+    for (size_t i = 0; i < Capacity; ++i) {
+        items[i] = std::make_pair(g_keys[i], static_cast<uint32_t>(i));
+    }
+    estl_time = measure(Capacity,
+        [] { table.clear(); },
+        [] {
+            table.insert(items, items + Capacity);
+            bench::do_not_optimize(table);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity,
+        [&] { reference.clear(); },
+        [&] {
+            reference.insert(items, items + Capacity);
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("map insert(first, last)", Capacity, estl_time, std_time);
+
+    estl_time = measure(Capacity, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            sum += table.find(g_keys[i])->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity, no_setup, [&] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            sum += reference.find(g_keys[i])->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+#endif
+    print_row("map find", Capacity, estl_time, std_time);
+
+    estl_time = measure(Capacity,
+        [] {
+            table.clear();
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+        },
+        [] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.erase(g_keys[i]);
+            }
+            bench::do_not_optimize(table);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity,
+        [&] {
+            reference.clear();
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+        },
+        [&] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.erase(g_keys[i]);
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("map erase", Capacity, estl_time, std_time);
+}
+
+// Same cases as bench_map: O(log N) inserts and erases against the sorted
+// array's shifting
+template <size_t Capacity>
+void bench_btree_map() {
+    static estl::btree_map<uint32_t, uint32_t, estl::less<uint32_t>, Capacity> table;
+
+    double estl_time = measure(Capacity,
+        [] { table.clear(); },
+        [] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+            bench::do_not_optimize(table);
+        });
+    double std_time = -1.0;
+#if ESTL_BENCH_WITH_STD
+    std::map<uint32_t, uint32_t> reference;
+    std_time = measure(Capacity,
+        [&] { reference.clear(); },
+        [&] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("btree_map insert", Capacity, estl_time, std_time);
+
+    estl_time = measure(Capacity, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            sum += table.find(g_keys[i])->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity, no_setup, [&] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            sum += reference.find(g_keys[i])->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+#endif
+    print_row("btree_map find", Capacity, estl_time, std_time);
+
+    estl_time = measure(Capacity,
+        [] {
+            table.clear();
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+        },
+        [] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.erase(g_keys[i]);
+            }
+            bench::do_not_optimize(table);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity,
+        [&] {
+            reference.clear();
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+        },
+        [&] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.erase(g_keys[i]);
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("btree_map erase", Capacity, estl_time, std_time);
+}
+
+template <size_t Capacity>
+void bench_unordered_map() {
+    // Half-full table, the intended operating point for open addressing
+    static estl::unordered_map<uint32_t, uint32_t, estl::hash<uint32_t>,
+                               estl::equal_to<uint32_t>, 2 * Capacity> table;
+
+    double estl_time = measure(Capacity,
+        [] { table.clear(); },
+        [] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+            bench::do_not_optimize(table);
+        });
+    double std_time = -1.0;
+#if ESTL_BENCH_WITH_STD
+    std::unordered_map<uint32_t, uint32_t> reference;
+    reference.reserve(2 * Capacity);
+    std_time = measure(Capacity,
+        [&] { reference.clear(); },
+        [&] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("unordered_map insert", Capacity, estl_time, std_time);
+
+    estl_time = measure(Capacity, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            sum += table.find(g_keys[i])->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity, no_setup, [&] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            sum += reference.find(g_keys[i])->second;
+        }
+        bench::do_not_optimize(sum);
+    });
+#endif
+    print_row("unordered_map find", Capacity, estl_time, std_time);
+
+    estl_time = measure(Capacity,
+        [] {
+            table.clear();
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+        },
+        [] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                table.erase(g_keys[i]);
+            }
+            bench::do_not_optimize(table);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(Capacity,
+        [&] {
+            reference.clear();
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+            }
+        },
+        [&] {
+            for (size_t i = 0; i < Capacity; ++i) {
+                reference.erase(g_keys[i]);
+            }
+            bench::do_not_optimize(reference);
+        });
+#endif
+    print_row("unordered_map erase", Capacity, estl_time, std_time);
+}
+
+// Large mapped values: map drags them through the cache, flat_map does not
+struct large_config {
+    uint32_t key_copy;
+    uint8_t payload[196];
+};
+
+void bench_flat_map() {
+    const size_t kCount = 128;
+    static estl::map<uint16_t, large_config, estl::less<uint16_t>, kCount> packed;
+    static estl::flat_map<uint16_t, large_config, estl::less<uint16_t>, kCount> split;
+    large_config config = large_config();
+    for (size_t i = 0; i < kCount; ++i) {
+        config.key_copy = static_cast<uint32_t>(i);
+        packed.insert(std::make_pair(static_cast<uint16_t>(g_keys[i]), config));
+        split.insert(std::make_pair(static_cast<uint16_t>(g_keys[i]), config));
+    }
+
+    double map_time = measure(kCount, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            sum += packed.find(static_cast<uint16_t>(g_keys[i]))->second.key_copy;
+        }
+        bench::do_not_optimize(sum);
+    });
+    double flat_time = measure(kCount, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kCount; ++i) {
+            sum += split.find(static_cast<uint16_t>(g_keys[i]))->second.key_copy;
+        }
+        bench::do_not_optimize(sum);
+    });
+    print_row("map find, 200-byte values", kCount, map_time, -1.0);
+    print_row("flat_map find, 200-byte values", kCount, flat_time, -1.0);
+}
+
+// Algorithms
+void bench_algorithms() {
+    double estl_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            estl::sort(g_work, g_work + kSortSize);
+            bench::do_not_optimize(g_work);
+        });
+    double std_time = -1.0;
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            std::sort(g_work, g_work + kSortSize);
+            bench::do_not_optimize(g_work);
+        });
+#endif
+    print_row("sort (random)", kSortSize, estl_time, std_time);
+    const double std_sort_time = std_time;
+
+    estl_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            estl::nth_element(g_work, g_work + kSortSize / 2, g_work + kSortSize);
+            bench::do_not_optimize(g_work);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            std::nth_element(g_work, g_work + kSortSize / 2, g_work + kSortSize);
+            bench::do_not_optimize(g_work);
+        });
+#endif
+    print_row("nth_element (median)", kSortSize, estl_time, std_time);
+
+    // Merges into a scratch buffer of N / 2 elements against std's allocation
+    static uint32_t scratch[kSortSize / 2];
+    estl_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            estl::stable_sort(g_work, g_work + kSortSize, scratch, kSortSize / 2);
+            bench::do_not_optimize(g_work);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            std::stable_sort(g_work, g_work + kSortSize);
+            bench::do_not_optimize(g_work);
+        });
+#endif
+    print_row("stable_sort (random)", kSortSize, estl_time, std_time);
+
+    // Four counting passes over a buffer of N elements, against std::sort
+    static uint32_t radix_scratch[kSortSize];
+    estl_time = measure(kSortSize,
+        [] { estl::copy(g_keys, g_keys + kSortSize, g_work); },
+        [] {
+            estl::radix_sort(g_work, g_work + kSortSize, radix_scratch, kSortSize);
+            bench::do_not_optimize(g_work);
+        });
+    print_row("radix_sort (random)", kSortSize, estl_time, std_sort_time);
+
+    // One histogram pass over byte-sized keys, against std::sort
+    static uint8_t byte_keys[kSortSize];
+    static uint8_t byte_work[kSortSize];
+    for (size_t i = 0; i < kSortSize; ++i) {
+        byte_keys[i] = static_cast<uint8_t>(g_keys[i]);
+    }
+    estl_time = measure(kSortSize,
+        [] { estl::copy(byte_keys, byte_keys + kSortSize, byte_work); },
+        [] {
+            estl::counting_sort(byte_work, byte_work + kSortSize);
+            bench::do_not_optimize(byte_work);
+        });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kSortSize,
+        [] { estl::copy(byte_keys, byte_keys + kSortSize, byte_work); },
+        [] {
+            std::sort(byte_work, byte_work + kSortSize);
+            bench::do_not_optimize(byte_work);
+        });
+#endif
+    print_row("counting_sort (uint8_t)", kSortSize, estl_time, std_time);
+
+    estl::copy(g_keys, g_keys + kSortSize, g_work);
+    estl::sort(g_work, g_work + kSortSize);
+
+    // g_work is sorted from here on
+    estl_time = measure(kSortSize, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kSortSize; ++i) {
+            sum += *estl::lower_bound(g_work, g_work + kSortSize, g_keys[i]);
+        }
+        bench::do_not_optimize(sum);
+    });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kSortSize, no_setup, [] {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kSortSize; ++i) {
+            sum += *std::lower_bound(g_work, g_work + kSortSize, g_keys[i]);
+        }
+        bench::do_not_optimize(sum);
+    });
+#endif
+    print_row("lower_bound", kSortSize, estl_time, std_time);
+
+    // Linear search for a value that is not present: a full scan per call
+    const uint32_t missing = 0xFFFFFFFFu;
+    estl_time = measure(kSortSize, no_setup, [&] {
+        bench::do_not_optimize(estl::find(g_keys, g_keys + kSortSize, missing));
+    });
+#if ESTL_BENCH_WITH_STD
+    std_time = measure(kSortSize, no_setup, [&] {
+        bench::do_not_optimize(std::find(g_keys, g_keys + kSortSize, missing));
+    });
+#endif
+    print_row("find (per element)", kSortSize, estl_time, std_time);
+}
+
+// Slot occupancy with one slot in 16 taken: packed words against the
+// byte-per-flag vector<bool> they replace
+estl::bitset<kSortSize> g_slots;
+estl::vector<bool, kSortSize> g_slot_flags;
+
+void bench_bitset() {
+    g_slot_flags.clear();
+    for (size_t i = 0; i < kSortSize; ++i) {
+        bool taken = (g_keys[i] % 16) == 0;
+        g_slots.set(i, taken);
+        g_slot_flags.push_back(taken);
+    }
+
+    double estl_time = measure(kSortSize, no_setup, [] {
+        size_t sum = 0;
+        for (size_t i = g_slots.find_first_set(); i < kSortSize; i = g_slots.find_next(i)) {
+            sum += i;
+        }
+        bench::do_not_optimize(sum);
+    });
+    double flags_time = measure(kSortSize, no_setup, [] {
+        size_t sum = 0;
+        for (size_t i = 0; i < kSortSize; ++i) {
+            if (g_slot_flags[i]) {
+                sum += i;
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+    print_row("bitset scan vs vector<bool>", kSortSize, estl_time, flags_time);
+
+    estl_time = measure(kSortSize, no_setup, [] {
+        size_t count = g_slots.count();
+        bench::do_not_optimize(count);
+    });
+    flags_time = measure(kSortSize, no_setup, [] {
+        size_t count = estl::count(g_slot_flags.begin(), g_slot_flags.end(), true);
+        bench::do_not_optimize(count);
+    });
+    print_row("bitset count vs vector<bool>", kSortSize, estl_time, flags_time);
+}
+
+// Formatting: a log line with an integer and a fixed-point value. snprintf
+// is the comparison on every target, it is what fixed_string replaces.
+void bench_formatting() {
+    const size_t kLines = 256;
+    double estl_time = measure(kLines, no_setup, [] {
+        for (size_t i = 0; i < kLines; ++i) {
+            estl::fixed_string<64> line("id=");
+            line.append_number(g_keys[i]).append(" t=").append_fixed(static_cast<double>(g_keys[i] % 10000u) / 100.0, 2);
+            bench::do_not_optimize(line);
+        }
+    });
+    double printf_time = measure(kLines, no_setup, [] {
+        for (size_t i = 0; i < kLines; ++i) {
+            char line[65];
+            snprintf(line, sizeof(line), "id=%u t=%.2f", static_cast<unsigned>(g_keys[i]),
+                     static_cast<double>(g_keys[i] % 10000u) / 100.0);
+            bench::do_not_optimize(line);
+        }
+    });
+    print_row("log line (fixed_string vs snprintf)", estl_time, printf_time);
+}
+
+// Boot-time table load: opening a map image in place against rebuilding the
+// map by inserting each record
+const size_t kTableSize = 256;
+alignas(8) unsigned char g_image[kTableSize * 8 + 64];
+size_t g_image_size = 0;
+
+struct image_sink {
+    bool operator()(const void* data, size_t size) {
+        if (g_image_size + size > sizeof(g_image)) {
+            return false;
+        }
+        memcpy(g_image + g_image_size, data, size);
+        g_image_size += size;
+        return true;
+    }
+};
+
+estl::map<uint32_t, uint32_t, estl::less<uint32_t>, kTableSize> g_table;
+
+void bench_image() {
+    g_table.clear();
+    for (size_t i = 0; i < kTableSize; ++i) {
+        g_table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+    }
+    image_sink sink;
+    g_image_size = 0;
+    estl::write_image(sink, g_table);
+
+    double open_time = measure(1, no_setup, [] {
+        estl::map_image<uint32_t, uint32_t> table(g_image, g_image_size);
+        bench::do_not_optimize(table);
+    });
+    double verify_time = measure(1, no_setup, [] {
+        estl::map_image<uint32_t, uint32_t> table(g_image, g_image_size);
+        bool ok = table.verify();
+        bench::do_not_optimize(ok);
+    });
+    double insert_time = measure(1, [] { g_table.clear(); }, [] {
+        for (size_t i = 0; i < kTableSize; ++i) {
+            g_table.insert(std::make_pair(g_keys[i], static_cast<uint32_t>(i)));
+        }
+        bench::do_not_optimize(g_table);
+    });
+    print_row("image open vs map inserts", kTableSize, open_time, insert_time);
+    print_row("image verify vs map inserts", kTableSize, verify_time, insert_time);
+}
+
+} // namespace
+
+int main() {
+    bench::timer_init();
+    fill_keys(kSortSize);
+
+    printf("estl benchmarks, time per operation in %s\n\n", bench::timer_unit());
+    print_header();
+
+    bench_vector();
+    bench_map<16>();
+    bench_map<64>();
+    bench_map<256>();
+    bench_map<2048>();
+    bench_btree_map<256>();
+    bench_btree_map<2048>();
+    bench_unordered_map<16>();
+    bench_unordered_map<64>();
+    bench_unordered_map<256>();
+    bench_flat_map();
+    bench_algorithms();
+    bench_bitset();
+    bench_formatting();
+    bench_image();
+
+    return 0;
+}
@@ -10,10 +10,37 @@
  */
 
 #include "estl/config.hpp"
+#include "estl/utility.hpp"
+#include "estl/bit.hpp"
 #include "estl/iterator.hpp"
+#include "estl/memory.hpp"
+#include "estl/pool.hpp"
+#include "estl/stats.hpp"
+#include "estl/overflow.hpp"
 #include "estl/algorithm.hpp"
+#include "estl/span.hpp"
+#include "estl/string_view.hpp"
+#include "estl/charconv.hpp"
+#include "estl/fixed_string.hpp"
+#include "estl/bitset.hpp"
 #include "estl/vector.hpp"
+#include "estl/small_vector.hpp"
+#include "estl/intrusive_list.hpp"
+#include "estl/intrusive_heap.hpp"
+#include "estl/priority_queue.hpp"
+#include "estl/sliding_median.hpp"
+#include "estl/timer_wheel.hpp"
 #include "estl/map.hpp"
+#include "estl/btree_map.hpp"
+#include "estl/flat_map.hpp"
+#include "estl/frozen_map.hpp"
+#include "estl/image.hpp"
+#include "estl/hash.hpp"
+#include "estl/unordered_map.hpp"
+#include "estl/atomic.hpp"
+#include "estl/spsc_ring.hpp"
+#include "estl/mpmc_queue.hpp"
+#include "estl/execution.hpp"
 
 /**
  * @namespace estl
@@ -2,29 +2,35 @@
 #define ESTL_ALGORITHM_HPP
 
 #include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
 #include "config.hpp"
 #include "iterator.hpp"
+#include "memory.hpp"
+#include "simd.hpp"
 
 namespace estl {
 
 // Comparison operations
 template<typename T>
 struct less {
-    bool operator()(const T& lhs, const T& rhs) const {
+    constexpr bool operator()(const T& lhs, const T& rhs) const {
         return lhs < rhs;
     }
 };
 
 template<typename T>
 struct greater {
-    bool operator()(const T& lhs, const T& rhs) const {
+    constexpr bool operator()(const T& lhs, const T& rhs) const {
         return lhs > rhs;
     }
 };
 
 template<typename T>
 struct equal_to {
-    bool operator()(const T& lhs, const T& rhs) const {
+    constexpr bool operator()(const T& lhs, const T& rhs) const {
         return lhs == rhs;
     }
 };
@@ -60,8 +66,25 @@ bool none_of(InputIt first, InputIt last, UnaryPredicate p) {
     return true;
 }
 
+template<typename InputIt, typename UnaryFunction>
+UnaryFunction for_each(InputIt first, InputIt last, UnaryFunction f) {
+    for (; first != last; ++first) {
+        f(*first);
+    }
+    return f;
+}
+
+namespace detail {
+
+// True when find/count can run a vectorized kernel: a pointer range of
+// small integers searched for an integer value
 template<typename InputIt, typename T>
-InputIt find(InputIt first, InputIt last, const T& value) {
+struct is_vectorizable_search
+    : std::integral_constant<bool,
+        is_vectorizable_range<InputIt>::value && std::is_integral<T>::value> {};
+
+template<typename InputIt, typename T>
+InputIt find_impl(InputIt first, InputIt last, const T& value, std::false_type) {
     for (; first != last; ++first) {
         if (*first == value) {
             return first;
@@ -70,6 +93,54 @@ InputIt find(InputIt first, InputIt last, const T& value) {
     return last;
 }
 
+template<typename InputIt, typename T>
+InputIt find_impl(InputIt first, InputIt last, const T& value, std::true_type) {
+    using element = typename std::remove_const<typename iterator_traits<InputIt>::value_type>::type;
+    using lanes = typename std::make_unsigned<element>::type;
+
+    // A value the element type cannot represent compares unequal to every element
+    const element narrowed = static_cast<element>(value);
+    if (!(narrowed == value)) {
+        return last;
+    }
+    const lanes* base = reinterpret_cast<const lanes*>(first);
+    return first + (simd_find(base, base + (last - first), static_cast<lanes>(narrowed)) - base);
+}
+
+template<typename InputIt, typename T>
+typename iterator_traits<InputIt>::difference_type
+count_impl(InputIt first, InputIt last, const T& value, std::false_type) {
+    typename iterator_traits<InputIt>::difference_type result = 0;
+    for (; first != last; ++first) {
+        if (*first == value) {
+            ++result;
+        }
+    }
+    return result;
+}
+
+template<typename InputIt, typename T>
+typename iterator_traits<InputIt>::difference_type
+count_impl(InputIt first, InputIt last, const T& value, std::true_type) {
+    using element = typename std::remove_const<typename iterator_traits<InputIt>::value_type>::type;
+    using lanes = typename std::make_unsigned<element>::type;
+
+    const element narrowed = static_cast<element>(value);
+    if (!(narrowed == value)) {
+        return 0;
+    }
+    const lanes* base = reinterpret_cast<const lanes*>(first);
+    return static_cast<typename iterator_traits<InputIt>::difference_type>(
+        simd_count(base, base + (last - first), static_cast<lanes>(narrowed)));
+}
+
+} // namespace detail
+
+template<typename InputIt, typename T>
+InputIt find(InputIt first, InputIt last, const T& value) {
+    return detail::find_impl(first, last, value, detail::is_vectorizable_search<InputIt, T>());
+}
+
 template<typename InputIt, typename UnaryPredicate>
 InputIt find_if(InputIt first, InputIt last, UnaryPredicate p) {
     for (; first != last; ++first) {
@@ -93,13 +164,7 @@ InputIt find_if_not(InputIt first, InputIt last, UnaryPredicate p) {
 template<typename InputIt, typename T>
 typename iterator_traits<InputIt>::difference_type
 count(InputIt first, InputIt last, const T& value) {
-    typename iterator_traits<InputIt>::difference_type result = 0;
-    for (; first != last; ++first) {
-        if (*first == value) {
-            ++result;
-        }
-    }
-    return result;
+    return detail::count_impl(first, last, value, detail::is_vectorizable_search<InputIt, T>());
 }
 
 template<typename InputIt, typename UnaryPredicate>
@@ -114,16 +179,83 @@ count_if(InputIt first, InputIt last, UnaryPredicate p) {
     return result;
 }
 
+template<typename InputIt1, typename InputIt2>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+    for (; first1 != last1; ++first1, ++first2) {
+        if (!(*first1 == *first2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename InputIt1, typename InputIt2, typename BinaryPredicate>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p) {
+    for (; first1 != last1; ++first1, ++first2) {
+        if (!p(*first1, *first2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Modifying sequence operations
+namespace detail {
+
+// True when InputIt and OutputIt are pointers to the same trivially
+// copyable type, so element-wise assignment is equivalent to memmove
+template<typename InputIt, typename OutputIt>
+struct is_bitwise_assignable_range : std::false_type {};
+
+template<typename U, typename T>
+struct is_bitwise_assignable_range<U*, T*>
+    : std::integral_constant<bool,
+        std::is_same<typename std::remove_const<U>::type, T>::value &&
+        std::is_trivially_copyable<T>::value> {};
+
+// True when ForwardIt points to a byte-sized trivially copyable type,
+// so filling can be done with memset
+template<typename ForwardIt>
+struct is_byte_fillable : std::false_type {};
+
+template<typename T>
+struct is_byte_fillable<T*>
+    : std::integral_constant<bool,
+        sizeof(T) == 1 && std::is_trivially_copyable<T>::value && !std::is_const<T>::value> {};
+
+// Wider integers than bytes go through the vectorized kernel where available
 template<typename ForwardIt, typename T>
-void fill(ForwardIt first, ForwardIt last, const T& value) {
+void fill_elements(ForwardIt first, ForwardIt last, const T& value, std::false_type) {
     for (; first != last; ++first) {
         *first = value;
     }
 }
 
+template<typename ForwardIt, typename T>
+void fill_elements(ForwardIt first, ForwardIt last, const T& value, std::true_type) {
+    using element = typename iterator_traits<ForwardIt>::value_type;
+    using lanes = typename std::make_unsigned<element>::type;
+    lanes* base = reinterpret_cast<lanes*>(first);
+    simd_fill(base, base + (last - first), static_cast<lanes>(static_cast<element>(value)));
+}
+
+template<typename ForwardIt, typename T>
+void fill_impl(ForwardIt first, ForwardIt last, const T& value, std::false_type) {
+    fill_elements(first, last, value, is_vectorizable_range<ForwardIt>());
+}
+
+template<typename ForwardIt, typename T>
+void fill_impl(ForwardIt first, ForwardIt last, const T& value, std::true_type) {
+    if (first != last) {
+        typename iterator_traits<ForwardIt>::value_type element = value;
+        unsigned char byte;
+        std::memcpy(&byte, &element, 1);
+        std::memset(first, byte, static_cast<size_t>(last - first));
+    }
+}
+
 template<typename OutputIt, typename Size, typename T>
-OutputIt fill_n(OutputIt first, Size count, const T& value) {
+OutputIt fill_n_elements(OutputIt first, Size count, const T& value, std::false_type) {
     for (Size i = 0; i < count; ++i) {
         *first = value;
         ++first;
@@ -131,14 +263,79 @@ OutputIt fill_n(OutputIt first, Size count, const T& value) {
     return first;
 }
 
+template<typename OutputIt, typename Size, typename T>
+OutputIt fill_n_elements(OutputIt first, Size count, const T& value, std::true_type) {
+    if (count <= 0) {
+        return first;
+    }
+    fill_elements(first, first + count, value, std::true_type());
+    return first + count;
+}
+
+template<typename OutputIt, typename Size, typename T>
+OutputIt fill_n_impl(OutputIt first, Size count, const T& value, std::false_type) {
+    return fill_n_elements(first, count, value, is_vectorizable_range<OutputIt>());
+}
+
+template<typename OutputIt, typename Size, typename T>
+OutputIt fill_n_impl(OutputIt first, Size count, const T& value, std::true_type) {
+    if (count <= 0) {
+        return first;
+    }
+    fill_impl(first, first + count, value, std::true_type());
+    return first + count;
+}
+
 template<typename InputIt, typename OutputIt>
-OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+OutputIt copy_impl(InputIt first, InputIt last, OutputIt d_first, std::false_type) {
     for (; first != last; ++first, ++d_first) {
         *d_first = *first;
     }
     return d_first;
 }
 
+template<typename InputIt, typename OutputIt>
+OutputIt move_impl(InputIt first, InputIt last, OutputIt d_first, std::false_type) {
+    for (; first != last; ++first, ++d_first) {
+        *d_first = std::move(*first);
+    }
+    return d_first;
+}
+
+// Moving a trivially copyable type is a copy; memmove also tolerates the
+// overlapping left shifts std::copy and std::move permit
+template<typename InputIt, typename OutputIt>
+OutputIt copy_impl(InputIt first, InputIt last, OutputIt d_first, std::true_type) {
+    size_t count = static_cast<size_t>(last - first);
+    if (count > 0) {
+        std::memmove(d_first, first, count * sizeof(*first));
+    }
+    return d_first + count;
+}
+
+template<typename InputIt, typename OutputIt>
+OutputIt move_impl(InputIt first, InputIt last, OutputIt d_first, std::true_type) {
+    return copy_impl(first, last, d_first, std::true_type());
+}
+
+} // namespace detail
+
+template<typename ForwardIt, typename T>
+void fill(ForwardIt first, ForwardIt last, const T& value) {
+    detail::fill_impl(first, last, value, detail::is_byte_fillable<ForwardIt>());
+}
+
+template<typename OutputIt, typename Size, typename T>
+OutputIt fill_n(OutputIt first, Size count, const T& value) {
+    return detail::fill_n_impl(first, count, value, detail::is_byte_fillable<OutputIt>());
+}
+
+template<typename InputIt, typename OutputIt>
+OutputIt copy(InputIt first, InputIt last, OutputIt d_first) {
+    return detail::copy_impl(first, last, d_first,
+        detail::is_bitwise_assignable_range<InputIt, OutputIt>());
+}
+
 template<typename InputIt, typename OutputIt, typename UnaryPredicate>
 OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first, UnaryPredicate pred) {
     for (; first != last; ++first) {
@@ -152,8 +349,22 @@ OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first, UnaryPredicate p
 
 template<typename InputIt, typename OutputIt>
 OutputIt move(InputIt first, InputIt last, OutputIt d_first) {
+    return detail::move_impl(first, last, d_first,
+        detail::is_bitwise_assignable_range<InputIt, OutputIt>());
+}
+
+template<typename InputIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(InputIt first, InputIt last, OutputIt d_first, UnaryOperation op) {
     for (; first != last; ++first, ++d_first) {
-        *d_first = std::move(*first);
+        *d_first = op(*first);
+    }
+    return d_first;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOperation>
+OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt d_first, BinaryOperation op) {
+    for (; first1 != last1; ++first1, ++first2, ++d_first) {
+        *d_first = op(*first1, *first2);
     }
     return d_first;
 }
@@ -185,32 +396,427 @@ void replace_if(ForwardIt first, ForwardIt last, UnaryPredicate p, const T& new_
     }
 }
 
-// Sorting and related operations
-template<typename RandomIt>
-void sort(RandomIt first, RandomIt last) {
-    sort(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+template<typename ForwardIt, typename BinaryPredicate>
+ForwardIt unique(ForwardIt first, ForwardIt last, BinaryPredicate p) {
+    if (first == last) {
+        return last;
+    }
+    ForwardIt result = first;
+    while (++first != last) {
+        if (!p(*result, *first) && ++result != first) {
+            *result = std::move(*first);
+        }
+    }
+    return ++result;
+}
+
+// Removes consecutive duplicates, e.g. from a sorted sample buffer, in one
+// pass; the elements past the returned end are left moved-from
+template<typename ForwardIt>
+ForwardIt unique(ForwardIt first, ForwardIt last) {
+    return estl::unique(first, last, equal_to<typename iterator_traits<ForwardIt>::value_type>());
+}
+
+// Moves the elements satisfying p before the others, not preserving order
+template<typename ForwardIt, typename UnaryPredicate>
+ForwardIt partition(ForwardIt first, ForwardIt last, UnaryPredicate p) {
+    using std::swap;
+    first = estl::find_if_not(first, last, p);
+    if (first == last) {
+        return first;
+    }
+    for (ForwardIt it = first; ++it != last;) {
+        if (p(*it)) {
+            swap(*it, *first);
+            ++first;
+        }
+    }
+    return first;
+}
+
+template<typename BidirIt>
+void reverse(BidirIt first, BidirIt last) {
+    using std::swap;
+    while (first != last && first != --last) {
+        swap(*first, *last);
+        ++first;
+    }
 }
 
+// Makes middle the first element; returns where first ended up. Iterative
+// block swaps, so forward iterators and no extra storage suffice.
+template<typename ForwardIt>
+ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {
+    using std::swap;
+    if (first == middle) {
+        return last;
+    }
+    if (middle == last) {
+        return first;
+    }
+    ForwardIt next = middle;
+    do {
+        swap(*first, *next);
+        ++first;
+        ++next;
+        if (first == middle) {
+            middle = next;
+        }
+    } while (next != last);
+
+    ForwardIt result = first;
+    next = middle;
+    while (next != last) {
+        swap(*first, *next);
+        ++first;
+        ++next;
+        if (first == middle) {
+            middle = next;
+        } else if (next == last) {
+            next = middle;
+        }
+    }
+    return result;
+}
+
+// Sorting and related operations
+namespace detail {
+
 template<typename RandomIt, typename Compare>
-void sort(RandomIt first, RandomIt last, Compare comp) {
-    if (first == last || first + 1 == last) {
+void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+    if (first == last) {
         return;
     }
-    
-    // Simple insertion sort for small arrays
+
     for (RandomIt it = first + 1; it != last; ++it) {
         auto key = std::move(*it);
         RandomIt j = it;
-        
+
         while (j > first && comp(key, *(j - 1))) {
             *j = std::move(*(j - 1));
             --j;
         }
-        
+
         *j = std::move(key);
     }
 }
 
+template<typename RandomIt, typename Distance, typename Compare>
+void sift_down(RandomIt first, Distance index, Distance len, Compare comp) {
+    auto value = std::move(*(first + index));
+
+    for (;;) {
+        Distance child = 2 * index + 1;
+        if (child >= len) {
+            break;
+        }
+        if (child + 1 < len && comp(*(first + child), *(first + (child + 1)))) {
+            ++child;
+        }
+        if (!comp(value, *(first + child))) {
+            break;
+        }
+        *(first + index) = std::move(*(first + child));
+        index = child;
+    }
+
+    *(first + index) = std::move(value);
+}
+
+// Moves *(first + index) up towards the root until its parent does not
+// compare less
+template<typename RandomIt, typename Distance, typename Compare>
+void sift_up(RandomIt first, Distance index, Compare comp) {
+    auto value = std::move(*(first + index));
+
+    while (index > 0) {
+        Distance parent = (index - 1) / 2;
+        if (!comp(*(first + parent), value)) {
+            break;
+        }
+        *(first + index) = std::move(*(first + parent));
+        index = parent;
+    }
+
+    *(first + index) = std::move(value);
+}
+
+template<typename RandomIt, typename Compare>
+void heap_sort(RandomIt first, RandomIt last, Compare comp) {
+    using std::swap;
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    Distance len = last - first;
+
+    for (Distance i = len / 2; i > 0; --i) {
+        sift_down(first, i - 1, len, comp);
+    }
+    while (len > 1) {
+        --len;
+        swap(*first, *(first + len));
+        sift_down(first, Distance(0), len, comp);
+    }
+}
+
+// Moves the median of *a, *b and *c into *result
+template<typename RandomIt, typename Compare>
+void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+    using std::swap;
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) {
+            swap(*result, *b);
+        } else if (comp(*a, *c)) {
+            swap(*result, *c);
+        } else {
+            swap(*result, *a);
+        }
+    } else if (comp(*a, *c)) {
+        swap(*result, *a);
+    } else if (comp(*b, *c)) {
+        swap(*result, *c);
+    } else {
+        swap(*result, *b);
+    }
+}
+
+// Hoare partition around *pivot; the median-of-three guarantees the scans
+// stop inside [first, last) without bounds checks
+template<typename RandomIt, typename Compare>
+RandomIt unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare comp) {
+    using std::swap;
+    for (;;) {
+        while (comp(*first, *pivot)) {
+            ++first;
+        }
+        --last;
+        while (comp(*pivot, *last)) {
+            --last;
+        }
+        if (!(first < last)) {
+            return first;
+        }
+        swap(*first, *last);
+        ++first;
+    }
+}
+
+// Maps an integer key to an unsigned one in the same order; the sign bit of
+// a signed key is flipped so negative keys come first
+template<typename Key>
+typename std::make_unsigned<Key>::type radix_key(Key key) {
+    typedef typename std::make_unsigned<Key>::type Unsigned;
+    return std::is_signed<Key>::value
+        ? static_cast<Unsigned>(static_cast<Unsigned>(key) ^
+                                (Unsigned(1) << (std::numeric_limits<Unsigned>::digits - 1)))
+        : static_cast<Unsigned>(key);
+}
+
+// The byte-sized integer with radix_key b
+template<typename T>
+T radix_value(unsigned b) {
+    return static_cast<T>(static_cast<unsigned char>(b ^ (std::is_signed<T>::value ? 0x80u : 0u)));
+}
+
+struct radix_identity {
+    template<typename T>
+    const T& operator()(const T& value) const {
+        return value;
+    }
+};
+
+// True for the keys radix_sort handles
+template<typename Key>
+struct is_radix_key : std::integral_constant<bool, std::is_integral<Key>::value && !std::is_same<Key, bool>::value> {};
+
+// Rewrites a range of byte-sized integers from their histogram, from the
+// top bucket down when descending
+template<typename RandomIt>
+void counting_sort_bytes(RandomIt first, RandomIt last, bool descending) {
+    typedef typename iterator_traits<RandomIt>::value_type T;
+    size_t counts[256] = {};
+    for (RandomIt it = first; it != last; ++it) {
+        ++counts[estl::detail::radix_key(*it)];
+    }
+    for (unsigned i = 0; i < 256; ++i) {
+        unsigned b = descending ? 255 - i : i;
+        if (counts[b] != 0) {
+            first = estl::fill_n(first, counts[b], estl::detail::radix_value<T>(b));
+        }
+    }
+}
+
+// One stable counting pass of an LSD radix sort: moves the n elements at src
+// to dst ordered by the key byte at shift. Moves nothing and returns false
+// when all keys share that byte, as the pass would not change the order.
+template<typename SrcIt, typename DstIt, typename Distance, typename KeyFn>
+bool radix_pass(SrcIt src, DstIt dst, Distance n, unsigned shift, KeyFn& key) {
+    size_t offsets[256] = {};
+    for (Distance i = 0; i < n; ++i) {
+        ++offsets[(estl::detail::radix_key(key(src[i])) >> shift) & 0xFF];
+    }
+    size_t total = 0;
+    for (unsigned b = 0; b < 256; ++b) {
+        size_t count = offsets[b];
+        if (count == static_cast<size_t>(n)) {
+            return false;
+        }
+        offsets[b] = total;
+        total += count;
+    }
+    for (Distance i = 0; i < n; ++i) {
+        size_t& offset = offsets[(estl::detail::radix_key(key(src[i])) >> shift) & 0xFF];
+        dst[static_cast<Distance>(offset++)] = std::move(src[i]);
+    }
+    return true;
+}
+
+template<typename RandomIt, typename KeyFn>
+void radix_sort_impl(RandomIt first, RandomIt last, typename iterator_traits<RandomIt>::value_type* buffer,
+                     size_t buffer_size, KeyFn key) {
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    typedef typename std::decay<decltype(key(*first))>::type Key;
+    static_assert(is_radix_key<Key>::value, "radix_sort requires an integral, non-bool key");
+
+    Distance n = last - first;
+    if (n < 2) {
+        return;
+    }
+    ESTL_ASSERT(buffer_size >= static_cast<size_t>(n));
+    (void)buffer_size;
+
+    // Passes alternate between the range and the buffer
+    const unsigned bits = std::numeric_limits<typename std::make_unsigned<Key>::type>::digits;
+    bool in_buffer = false;
+    for (unsigned shift = 0; shift < bits; shift += 8) {
+        bool moved = in_buffer ? estl::detail::radix_pass(buffer, first, n, shift, key)
+                               : estl::detail::radix_pass(first, buffer, n, shift, key);
+        if (moved) {
+            in_buffer = !in_buffer;
+        }
+    }
+    if (in_buffer) {
+        estl::move(buffer, buffer + n, first);
+    }
+}
+
+// True when sort(first, last, comp) may count instead of compare: byte-sized
+// integers in their natural order, which counting reproduces exactly
+template<typename RandomIt, typename Compare, typename T = typename iterator_traits<RandomIt>::value_type>
+struct is_counting_sortable
+    : std::integral_constant<bool, (ESTL_SORT_COUNTING_THRESHOLD > 0) && is_radix_key<T>::value && sizeof(T) == 1 &&
+                                       (std::is_same<Compare, less<T>>::value ||
+                                        std::is_same<Compare, greater<T>>::value)> {};
+
+template<typename RandomIt, typename Compare>
+bool try_counting_sort(RandomIt, RandomIt, Compare, std::false_type) {
+    return false;
+}
+
+template<typename RandomIt, typename Compare>
+bool try_counting_sort(RandomIt first, RandomIt last, Compare, std::true_type) {
+    typedef typename iterator_traits<RandomIt>::value_type T;
+    if (last - first < ESTL_SORT_COUNTING_THRESHOLD) {
+        return false;
+    }
+    estl::detail::counting_sort_bytes(first, last, std::is_same<Compare, greater<T>>::value);
+    return true;
+}
+
+} // namespace detail
+
+template<typename RandomIt>
+void sort(RandomIt first, RandomIt last) {
+    sort(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief Sorts a range with an allocation-free, non-recursive introsort
+ *
+ * Quicksort with median-of-three pivots, insertion sort for ranges of at most
+ * ESTL_SORT_INSERTION_THRESHOLD elements and heapsort once the partition
+ * depth exceeds 2*log2(N), giving O(N log N) in the worst case.
+ *
+ * Pending partitions live on a fixed array of ESTL_SORT_STACK_DEPTH entries,
+ * each holding two iterators and an int. The larger side of every split is
+ * deferred and the smaller side processed first, so at most log2(N) entries
+ * are ever in use; should the array still fill up, the deferred range is
+ * heapsorted in place. Stack usage is therefore fixed at compile time,
+ * e.g. 32 * 12 = 384 bytes for pointer iterators on a 32-bit target.
+ *
+ * With ESTL_SORT_COUNTING_THRESHOLD set, byte-sized integers ordered by
+ * less or greater are counted instead, see counting_sort. That path adds a
+ * histogram of 256 size_t to the stack, 1 KB on a 32-bit target, so it is
+ * off by default.
+ */
+template<typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+
+    struct pending_range {
+        RandomIt first;
+        RandomIt last;
+        int depth;
+    };
+
+    if (last - first < 2) {
+        return;
+    }
+    if (detail::try_counting_sort(first, last, comp, detail::is_counting_sortable<RandomIt, Compare>())) {
+        return;
+    }
+
+    int depth = 0;
+    for (Distance n = last - first; n > 1; n >>= 1) {
+        depth += 2;
+    }
+
+    pending_range stack[ESTL_SORT_STACK_DEPTH];
+    size_t top = 0;
+
+    for (;;) {
+        while (last - first > ESTL_SORT_INSERTION_THRESHOLD) {
+            if (depth == 0) {
+                detail::heap_sort(first, last, comp);
+                first = last;
+                break;
+            }
+            --depth;
+
+            RandomIt mid = first + (last - first) / 2;
+            detail::move_median_to_first(first, first + 1, mid, last - 1, comp);
+            RandomIt cut = detail::unguarded_partition(first + 1, last, first, comp);
+
+            // Defer the larger side, keep going on the smaller one
+            pending_range larger;
+            if (cut - first < last - cut) {
+                larger.first = cut;
+                larger.last = last;
+                last = cut;
+            } else {
+                larger.first = first;
+                larger.last = cut;
+                first = cut;
+            }
+            larger.depth = depth;
+
+            if (top < ESTL_SORT_STACK_DEPTH) {
+                stack[top++] = larger;
+            } else {
+                detail::heap_sort(larger.first, larger.last, comp);
+            }
+        }
+
+        detail::insertion_sort(first, last, comp);
+
+        if (top == 0) {
+            break;
+        }
+        --top;
+        first = stack[top].first;
+        last = stack[top].last;
+        depth = stack[top].depth;
+    }
+}
+
 template<typename ForwardIt, typename T>
 ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value) {
     return lower_bound(first, last, value, less<T>());
@@ -218,12 +824,12 @@ ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value) {
 
 template<typename ForwardIt, typename T, typename Compare>
 ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
-    typename iterator_traits<ForwardIt>::difference_type count = distance(first, last);
+    typename iterator_traits<ForwardIt>::difference_type count = estl::distance(first, last);
     
     while (count > 0) {
         typename iterator_traits<ForwardIt>::difference_type step = count / 2;
         ForwardIt it = first;
-        advance(it, step);
+        estl::advance(it, step);
         
         if (comp(*it, value)) {
             first = ++it;
@@ -243,12 +849,12 @@ ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value) {
 
 template<typename ForwardIt, typename T, typename Compare>
 ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp) {
-    typename iterator_traits<ForwardIt>::difference_type count = distance(first, last);
+    typename iterator_traits<ForwardIt>::difference_type count = estl::distance(first, last);
     
     while (count > 0) {
         typename iterator_traits<ForwardIt>::difference_type step = count / 2;
         ForwardIt it = first;
-        advance(it, step);
+        estl::advance(it, step);
         
         if (!comp(value, *it)) {
             first = ++it;
@@ -261,6 +867,41 @@ ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value, Compare c
     return first;
 }
 
+namespace detail {
+
+// Binary searches for contiguous arrays of small keys, as in flat_map. The
+// range halves on every step whatever the comparison says, so the step
+// compiles to a conditional move and there is no branch to mispredict; the
+// plain versions above stop a step early instead but mispredict half their
+// comparisons on random keys.
+template<typename T, typename Key, typename Compare>
+const T* branchless_lower_bound(const T* first, size_t count, const Key& value, Compare comp) {
+    if (count == 0) {
+        return first;
+    }
+    while (count > 1) {
+        size_t half = count / 2;
+        first = comp(first[half], value) ? first + half : first;
+        count -= half;
+    }
+    return first + (comp(*first, value) ? 1 : 0);
+}
+
+template<typename T, typename Key, typename Compare>
+const T* branchless_upper_bound(const T* first, size_t count, const Key& value, Compare comp) {
+    if (count == 0) {
+        return first;
+    }
+    while (count > 1) {
+        size_t half = count / 2;
+        first = comp(value, first[half]) ? first : first + half;
+        count -= half;
+    }
+    return first + (comp(value, *first) ? 0 : 1);
+}
+
+} // namespace detail
+
 template<typename ForwardIt, typename T>
 bool binary_search(ForwardIt first, ForwardIt last, const T& value) {
     first = lower_bound(first, last, value);
@@ -273,6 +914,580 @@ bool binary_search(ForwardIt first, ForwardIt last, const T& value, Compare comp
     return (first != last && !comp(value, *first));
 }
 
+// Operations on sorted ranges
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first, Compare comp) {
+    for (; first1 != last1; ++d_first) {
+        if (first2 == last2) {
+            return estl::copy(first1, last1, d_first);
+        }
+        if (comp(*first2, *first1)) {
+            *d_first = *first2;
+            ++first2;
+        } else {
+            *d_first = *first1;
+            ++first1;
+        }
+    }
+    return estl::copy(first2, last2, d_first);
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return estl::merge(first1, last1, first2, last2, d_first,
+                       less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+namespace detail {
+
+// Merges [first, middle) and [middle, last) by moving the shorter run into
+// buffer, which holds at least that many elements
+template<typename BidirIt, typename Distance, typename Pointer, typename Compare>
+void merge_with_buffer(BidirIt first, BidirIt middle, BidirIt last, Distance len1, Distance len2,
+                       Pointer buffer, Compare comp) {
+    if (len1 <= len2) {
+        Pointer buffer_end = estl::move(first, middle, buffer);
+        for (; buffer != buffer_end && middle != last; ++first) {
+            if (comp(*middle, *buffer)) {
+                *first = std::move(*middle);
+                ++middle;
+            } else {
+                *first = std::move(*buffer);
+                ++buffer;
+            }
+        }
+        estl::move(buffer, buffer_end, first);
+        return;
+    }
+
+    // Backwards from last, so the left run is never overwritten unread
+    Pointer buffer_end = estl::move(middle, last, buffer);
+    while (buffer_end != buffer) {
+        if (middle == first) {
+            do {
+                *--last = std::move(*--buffer_end);
+            } while (buffer_end != buffer);
+            return;
+        }
+        BidirIt left = middle;
+        --left;
+        if (comp(*(buffer_end - 1), *left)) {
+            *--last = std::move(*left);
+            middle = left;
+        } else {
+            *--last = std::move(*--buffer_end);
+        }
+    }
+}
+
+// Splits the larger run in half, rotates the matching part of the other run
+// into place and merges both sides; recursion is on the left side only
+template<typename BidirIt, typename Distance, typename Pointer, typename Compare>
+void merge_adaptive(BidirIt first, BidirIt middle, BidirIt last, Distance len1, Distance len2,
+                    Pointer buffer, Distance buffer_size, Compare comp) {
+    using std::swap;
+    for (;;) {
+        if (len1 == 0 || len2 == 0) {
+            return;
+        }
+        if (len1 <= buffer_size || len2 <= buffer_size) {
+            merge_with_buffer(first, middle, last, len1, len2, buffer, comp);
+            return;
+        }
+        if (len1 + len2 == 2) {
+            if (comp(*middle, *first)) {
+                swap(*first, *middle);
+            }
+            return;
+        }
+
+        BidirIt first_cut = first;
+        BidirIt second_cut = middle;
+        Distance len11;
+        Distance len22;
+        if (len1 > len2) {
+            len11 = len1 / 2;
+            estl::advance(first_cut, len11);
+            second_cut = estl::lower_bound(middle, last, *first_cut, comp);
+            len22 = estl::distance(middle, second_cut);
+        } else {
+            len22 = len2 / 2;
+            estl::advance(second_cut, len22);
+            first_cut = estl::upper_bound(first, middle, *second_cut, comp);
+            len11 = estl::distance(first, first_cut);
+        }
+        BidirIt new_middle = estl::rotate(first_cut, middle, second_cut);
+        merge_adaptive(first, first_cut, new_middle, len11, len22, buffer, buffer_size, comp);
+
+        first = new_middle;
+        middle = second_cut;
+        len1 -= len11;
+        len2 -= len22;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Merges the sorted runs [first, middle) and [middle, last) in place
+ *
+ * Stable. The shorter run is moved into buffer (buffer_size constructed
+ * elements supplied by the caller, e.g. a static scratch array) when it
+ * fits, giving a linear merge. Otherwise the runs are split and rotated
+ * until the pieces fit, which with no buffer at all is O(N log N) swaps and
+ * O(log N) stack.
+ */
+template<typename BidirIt, typename Compare>
+void inplace_merge(BidirIt first, BidirIt middle, BidirIt last,
+                   typename iterator_traits<BidirIt>::value_type* buffer, size_t buffer_size, Compare comp) {
+    typedef typename iterator_traits<BidirIt>::difference_type Distance;
+    detail::merge_adaptive(first, middle, last, estl::distance(first, middle), estl::distance(middle, last),
+                           buffer, static_cast<Distance>(buffer_size), comp);
+}
+
+template<typename BidirIt>
+void inplace_merge(BidirIt first, BidirIt middle, BidirIt last,
+                   typename iterator_traits<BidirIt>::value_type* buffer, size_t buffer_size) {
+    estl::inplace_merge(first, middle, last, buffer, buffer_size,
+                        less<typename iterator_traits<BidirIt>::value_type>());
+}
+
+template<typename BidirIt, typename Compare>
+void inplace_merge(BidirIt first, BidirIt middle, BidirIt last, Compare comp) {
+    estl::inplace_merge(first, middle, last, static_cast<typename iterator_traits<BidirIt>::value_type*>(nullptr),
+                        0, comp);
+}
+
+template<typename BidirIt>
+void inplace_merge(BidirIt first, BidirIt middle, BidirIt last) {
+    estl::inplace_merge(first, middle, last, less<typename iterator_traits<BidirIt>::value_type>());
+}
+
+/**
+ * @brief A merge that writes a bounded number of elements per call
+ *
+ * Holds the cursors of estl::merge between calls to step(), so merging two
+ * long sorted ranges can be spread over main-loop iterations with a fixed
+ * cost per iteration. The ranges and the output must stay valid and
+ * unmodified until done().
+ */
+template<typename InputIt1, typename InputIt2, typename OutputIt,
+         typename Compare = less<typename iterator_traits<InputIt1>::value_type>>
+class incremental_merge : private Compare {
+public:
+    incremental_merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first,
+                      Compare comp = Compare())
+        : Compare(comp), m_first1(first1), m_last1(last1), m_first2(first2), m_last2(last2), m_out(d_first) {}
+
+    // Writes up to budget elements; true once both ranges are consumed
+    bool step(size_t budget) {
+        const Compare& comp = *this;
+        for (; budget > 0; --budget, ++m_out) {
+            if (m_first1 == m_last1) {
+                if (m_first2 == m_last2) {
+                    break;
+                }
+                *m_out = *m_first2;
+                ++m_first2;
+            } else if (m_first2 == m_last2 || !comp(*m_first2, *m_first1)) {
+                *m_out = *m_first1;
+                ++m_first1;
+            } else {
+                *m_out = *m_first2;
+                ++m_first2;
+            }
+        }
+        return done();
+    }
+
+    bool done() const {
+        return m_first1 == m_last1 && m_first2 == m_last2;
+    }
+
+    // One past the last element written
+    OutputIt out() const {
+        return m_out;
+    }
+
+private:
+    InputIt1 m_first1;
+    InputIt1 m_last1;
+    InputIt2 m_first2;
+    InputIt2 m_last2;
+    OutputIt m_out;
+};
+
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+incremental_merge<InputIt1, InputIt2, OutputIt, Compare>
+make_incremental_merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first,
+                       Compare comp) {
+    return incremental_merge<InputIt1, InputIt2, OutputIt, Compare>(first1, last1, first2, last2, d_first, comp);
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+incremental_merge<InputIt1, InputIt2, OutputIt>
+make_incremental_merge(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return incremental_merge<InputIt1, InputIt2, OutputIt>(first1, last1, first2, last2, d_first);
+}
+
+// Set operations on sorted ranges; elements equal under comp are taken
+// from the first range
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_union(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first,
+                   Compare comp) {
+    for (; first1 != last1; ++d_first) {
+        if (first2 == last2) {
+            return estl::copy(first1, last1, d_first);
+        }
+        if (comp(*first2, *first1)) {
+            *d_first = *first2;
+            ++first2;
+        } else {
+            *d_first = *first1;
+            if (!comp(*first1, *first2)) {
+                ++first2;
+            }
+            ++first1;
+        }
+    }
+    return estl::copy(first2, last2, d_first);
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_union(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return estl::set_union(first1, last1, first2, last2, d_first,
+                           less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_intersection(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first,
+                          Compare comp) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first1, *first2)) {
+            ++first1;
+        } else {
+            if (!comp(*first2, *first1)) {
+                *d_first = *first1;
+                ++d_first;
+                ++first1;
+            }
+            ++first2;
+        }
+    }
+    return d_first;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_intersection(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return estl::set_intersection(first1, last1, first2, last2, d_first,
+                                  less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt, typename Compare>
+OutputIt set_difference(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first,
+                        Compare comp) {
+    while (first1 != last1) {
+        if (first2 == last2) {
+            return estl::copy(first1, last1, d_first);
+        }
+        if (comp(*first1, *first2)) {
+            *d_first = *first1;
+            ++d_first;
+            ++first1;
+        } else {
+            if (!comp(*first2, *first1)) {
+                ++first1;
+            }
+            ++first2;
+        }
+    }
+    return d_first;
+}
+
+template<typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt set_difference(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first) {
+    return estl::set_difference(first1, last1, first2, last2, d_first,
+                                less<typename iterator_traits<InputIt1>::value_type>());
+}
+
+// Heap operations
+// Max-heaps with respect to comp, laid out like std::make_heap: the
+// children of element i are at 2i + 1 and 2i + 2
+
+template<typename RandomIt, typename Compare>
+void push_heap(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    if (last - first > 1) {
+        detail::sift_up(first, Distance(last - first - 1), comp);
+    }
+}
+
+template<typename RandomIt>
+void push_heap(RandomIt first, RandomIt last) {
+    estl::push_heap(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// Moves the top to *(last - 1) and restores the heap on [first, last - 1)
+template<typename RandomIt, typename Compare>
+void pop_heap(RandomIt first, RandomIt last, Compare comp) {
+    using std::swap;
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    Distance len = last - first;
+    if (len > 1) {
+        --len;
+        swap(*first, *(first + len));
+        detail::sift_down(first, Distance(0), len, comp);
+    }
+}
+
+template<typename RandomIt>
+void pop_heap(RandomIt first, RandomIt last) {
+    estl::pop_heap(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// O(N) bottom-up construction
+template<typename RandomIt, typename Compare>
+void make_heap(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    Distance len = last - first;
+    for (Distance i = len / 2; i > 0; --i) {
+        detail::sift_down(first, i - 1, len, comp);
+    }
+}
+
+template<typename RandomIt>
+void make_heap(RandomIt first, RandomIt last) {
+    estl::make_heap(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename RandomIt, typename Compare>
+void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+    for (; last - first > 1; --last) {
+        estl::pop_heap(first, last, comp);
+    }
+}
+
+template<typename RandomIt>
+void sort_heap(RandomIt first, RandomIt last) {
+    estl::sort_heap(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename RandomIt, typename Compare>
+RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp) {
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    Distance len = last - first;
+    for (Distance child = 1; child < len; ++child) {
+        if (comp(*(first + (child - 1) / 2), *(first + child))) {
+            return first + child;
+        }
+    }
+    return last;
+}
+
+template<typename RandomIt>
+RandomIt is_heap_until(RandomIt first, RandomIt last) {
+    return estl::is_heap_until(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename RandomIt, typename Compare>
+bool is_heap(RandomIt first, RandomIt last, Compare comp) {
+    return estl::is_heap_until(first, last, comp) == last;
+}
+
+template<typename RandomIt>
+bool is_heap(RandomIt first, RandomIt last) {
+    return estl::is_heap_until(first, last) == last;
+}
+
+// Partial and stable sorting
+namespace detail {
+
+// Leaves the middle - first smallest elements of [first, last) in
+// [first, middle) as a max-heap
+template<typename RandomIt, typename Compare>
+void heap_select(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+    using std::swap;
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    if (first == middle) {
+        return;
+    }
+    estl::make_heap(first, middle, comp);
+    Distance len = middle - first;
+    for (RandomIt it = middle; it < last; ++it) {
+        if (comp(*it, *first)) {
+            swap(*it, *first);
+            detail::sift_down(first, Distance(0), len, comp);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Sorts the middle - first smallest elements into [first, middle)
+ *
+ * Heap selection, O(N log K) for K = middle - first; the order of the
+ * remaining elements is unspecified.
+ */
+template<typename RandomIt, typename Compare>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+    detail::heap_select(first, middle, last, comp);
+    estl::sort_heap(first, middle, comp);
+}
+
+template<typename RandomIt>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+    estl::partial_sort(first, middle, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief Puts the element that belongs at nth in sorted order there
+ *
+ * Nothing before nth compares greater and nothing after it compares less,
+ * e.g. for a median or percentile without sorting the window. Introselect:
+ * the partitioning of estl::sort, continued on the side holding nth only,
+ * so O(N) on average; after 2*log2(N) partitions the rest is finished by
+ * heap selection, bounding the worst case at O(N log N).
+ */
+template<typename RandomIt, typename Compare>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+    using std::swap;
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    if (nth == last) {
+        return;
+    }
+
+    int depth = 0;
+    for (Distance n = last - first; n > 1; n >>= 1) {
+        depth += 2;
+    }
+
+    while (last - first > ESTL_SORT_INSERTION_THRESHOLD) {
+        if (depth == 0) {
+            detail::heap_select(first, nth + 1, last, comp);
+            swap(*first, *nth);
+            return;
+        }
+        --depth;
+        RandomIt mid = first + (last - first) / 2;
+        detail::move_median_to_first(first, first + 1, mid, last - 1, comp);
+        RandomIt cut = detail::unguarded_partition(first + 1, last, first, comp);
+        if (cut <= nth) {
+            first = cut;
+        } else {
+            last = cut;
+        }
+    }
+    detail::insertion_sort(first, last, comp);
+}
+
+template<typename RandomIt>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+    estl::nth_element(first, nth, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+/**
+ * @brief Sorts a range, keeping equal elements in their original order
+ *
+ * Bottom-up merge sort: runs of ESTL_SORT_INSERTION_THRESHOLD elements are
+ * insertion sorted, then merged pairwise with inplace_merge's strategy.
+ * With buffer_size of at least N / 2 every merge is linear and the sort is
+ * O(N log N); with a smaller buffer, or none, merges fall back to rotations
+ * and the sort is O(N log^2 N). Nothing is allocated, and the stack depth is
+ * O(log N).
+ */
+template<typename RandomIt, typename Compare>
+void stable_sort(RandomIt first, RandomIt last,
+                 typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size, Compare comp) {
+    typedef typename iterator_traits<RandomIt>::difference_type Distance;
+    const Distance run = (ESTL_SORT_INSERTION_THRESHOLD > 1) ? ESTL_SORT_INSERTION_THRESHOLD : 1;
+    Distance len = last - first;
+
+    for (Distance i = 0; i < len; i += run) {
+        detail::insertion_sort(first + i, first + ((len - i > run) ? i + run : len), comp);
+    }
+    for (Distance width = run; width < len; width *= 2) {
+        for (Distance i = 0; len - i > width; i += 2 * width) {
+            Distance rest = (len - i - width < width) ? len - i - width : width;
+            detail::merge_adaptive(first + i, first + (i + width), first + (i + width + rest), width, rest,
+                                   buffer, static_cast<Distance>(buffer_size), comp);
+        }
+    }
+}
+
+template<typename RandomIt>
+void stable_sort(RandomIt first, RandomIt last,
+                 typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size) {
+    estl::stable_sort(first, last, buffer, buffer_size, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+template<typename RandomIt, typename Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+    estl::stable_sort(first, last, static_cast<typename iterator_traits<RandomIt>::value_type*>(nullptr), 0, comp);
+}
+
+template<typename RandomIt>
+void stable_sort(RandomIt first, RandomIt last) {
+    estl::stable_sort(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// Integer sorting
+/**
+ * @brief Sorts byte-sized integers by counting them
+ *
+ * One pass builds a histogram of the 256 possible values and a second
+ * rewrites the range from it: O(N) with no buffer, the 256 size_t counters
+ * living on the stack. estl::sort does this by itself for less and greater
+ * when ESTL_SORT_COUNTING_THRESHOLD is set.
+ */
+template<typename RandomIt>
+void counting_sort(RandomIt first, RandomIt last) {
+    typedef typename iterator_traits<RandomIt>::value_type T;
+    static_assert(detail::is_radix_key<T>::value && sizeof(T) == 1,
+                  "counting_sort without a key requires byte-sized integers");
+    detail::counting_sort_bytes(first, last, false);
+}
+
+/**
+ * @brief Stable sort by a byte-sized integer key in one counting pass
+ *
+ * key(element) gives the key. The elements are moved into buffer
+ * (buffer_size constructed elements, at least last - first) by key and
+ * back, so O(N).
+ */
+template<typename RandomIt, typename KeyFn>
+void counting_sort(RandomIt first, RandomIt last,
+                   typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size, KeyFn key) {
+    typedef typename std::decay<decltype(key(*first))>::type Key;
+    static_assert(sizeof(Key) == 1, "counting_sort requires a byte-sized key; use radix_sort for wider ones");
+    detail::radix_sort_impl(first, last, buffer, buffer_size, key);
+}
+
+/**
+ * @brief Stable LSD radix sort by an integer key
+ *
+ * For integers, or structs sorted by an integer field, where comparisons
+ * are wasted work: one counting pass per key byte, least significant
+ * first, each moving the elements between the range and buffer (buffer_size
+ * constructed elements, at least last - first). O(N * sizeof(Key)); a pass
+ * is skipped when all keys share its byte, so small values in a wide type
+ * cost no more than a narrow type. Signed keys sort negative first. Each
+ * pass keeps 256 size_t counters on the stack.
+ *
+ * key(element) gives the key; without it the elements are the keys.
+ */
+template<typename RandomIt, typename KeyFn>
+void radix_sort(RandomIt first, RandomIt last,
+                typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size, KeyFn key) {
+    detail::radix_sort_impl(first, last, buffer, buffer_size, key);
+}
+
+template<typename RandomIt>
+void radix_sort(RandomIt first, RandomIt last,
+                typename iterator_traits<RandomIt>::value_type* buffer, size_t buffer_size) {
+    detail::radix_sort_impl(first, last, buffer, buffer_size, detail::radix_identity());
+}
+
 // Min/max operations
 template<typename T>
 const T& min(const T& a, const T& b) {
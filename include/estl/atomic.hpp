@@ -0,0 +1,111 @@
+#ifndef ESTL_ATOMIC_HPP
+#define ESTL_ATOMIC_HPP
+
+#include "config.hpp"
+
+#if ESTL_HAS_ATOMIC
+    #include <atomic>
+#endif
+
+namespace estl {
+
+namespace detail {
+
+#if ESTL_HAS_ATOMIC
+// Orderings behind atomic_value's operations, see ESTL_ATOMIC_SEQ_CST
+#if ESTL_ATOMIC_SEQ_CST
+constexpr std::memory_order relaxed_order = std::memory_order_seq_cst;
+constexpr std::memory_order acquire_order = std::memory_order_seq_cst;
+constexpr std::memory_order release_order = std::memory_order_seq_cst;
+#else
+constexpr std::memory_order relaxed_order = std::memory_order_relaxed;
+constexpr std::memory_order acquire_order = std::memory_order_acquire;
+constexpr std::memory_order release_order = std::memory_order_release;
+#endif
+#endif
+
+/**
+ * @brief Minimal atomic cell used by the lock-free containers
+ *
+ * Exposes only the orderings the containers need. Maps onto std::atomic when
+ * ESTL_HAS_ATOMIC is set, otherwise onto a volatile object fenced with
+ * ESTL_COMPILER_BARRIER (single-core targets only). T must be a type the
+ * target reads and writes in one instruction. The compare_exchange
+ * operations need real atomics and exist only with ESTL_HAS_ATOMIC.
+ */
+template <typename T>
+class atomic_value {
+public:
+    constexpr atomic_value() : m_value(0) {}
+    constexpr explicit atomic_value(T value) : m_value(value) {}
+
+    atomic_value(const atomic_value&) = delete;
+    atomic_value& operator=(const atomic_value&) = delete;
+
+#if ESTL_HAS_ATOMIC
+    T load_relaxed() const {
+        return m_value.load(relaxed_order);
+    }
+
+    T load_acquire() const {
+        return m_value.load(acquire_order);
+    }
+
+    void store_relaxed(T value) {
+        m_value.store(value, relaxed_order);
+    }
+
+    void store_release(T value) {
+        m_value.store(value, release_order);
+    }
+
+    // Sequentially consistent; on failure expected receives the current value
+    bool compare_exchange(T& expected, T desired) {
+        return m_value.compare_exchange_strong(expected, desired, std::memory_order_seq_cst, relaxed_order);
+    }
+
+    // Relaxed and allowed to fail spuriously, for retry loops that order
+    // their data through other accesses
+    bool compare_exchange_relaxed(T& expected, T desired) {
+        return m_value.compare_exchange_weak(expected, desired, relaxed_order, relaxed_order);
+    }
+
+private:
+    std::atomic<T> m_value;
+#else
+    T load_relaxed() const {
+        return m_value;
+    }
+
+    T load_acquire() const {
+        T value = m_value;
+        ESTL_COMPILER_BARRIER();
+        return value;
+    }
+
+    void store_relaxed(T value) {
+        m_value = value;
+    }
+
+    void store_release(T value) {
+        ESTL_COMPILER_BARRIER();
+        m_value = value;
+    }
+
+private:
+    volatile T m_value;
+#endif
+};
+
+#if ESTL_HAS_ATOMIC
+// Full fence, for the store-load orderings release/acquire cannot express
+inline void atomic_fence() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+#endif
+
+} // namespace detail
+
+} // namespace estl
+
+#endif // ESTL_ATOMIC_HPP
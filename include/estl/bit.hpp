@@ -0,0 +1,142 @@
+#ifndef ESTL_BIT_HPP
+#define ESTL_BIT_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "config.hpp"
+
+namespace estl {
+
+/**
+ * Bit counting
+ *
+ * C++11 stand-ins for the <bit> functions of C++20, for unsigned integers
+ * of up to 64 bits. With GCC and Clang they map to the compiler builtins,
+ * which become single instructions where the core has them: POPCNT and
+ * TZCNT/LZCNT on x86, CLZ (and RBIT+CLZ for the trailing count) on
+ * ARMv7-M and later. ARMv6-M and AVR get the library routines the
+ * compiler ships. Other compilers use the SWAR versions below.
+ *
+ * As in C++20, the counts of a zero value are the width of the type.
+ */
+
+namespace detail {
+
+template <typename T>
+struct bit_width_of : std::integral_constant<int, static_cast<int>(sizeof(T) * CHAR_BIT)> {};
+
+inline int swar_popcount(uint64_t value) {
+    value = value - ((value >> 1) & 0x5555555555555555ull);
+    value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<int>((value * 0x0101010101010101ull) >> 56);
+}
+
+// Bits below the lowest set bit, as a mask, then counted
+inline int swar_countr_zero(uint64_t value, int width) {
+    return (value == 0) ? width : estl::detail::swar_popcount((value & (0 - value)) - 1);
+}
+
+// Copies the highest set bit into every lower bit, then counts the rest
+inline int swar_countl_zero(uint64_t value, int width) {
+    value |= value >> 1;
+    value |= value >> 2;
+    value |= value >> 4;
+    value |= value >> 8;
+    value |= value >> 16;
+    value |= value >> 32;
+    return width - estl::detail::swar_popcount(value);
+}
+
+#if defined(__GNUC__)
+// The builtin taking the narrowest of unsigned, unsigned long and unsigned
+// long long that holds T
+template <typename T, int Rank = (sizeof(T) <= sizeof(unsigned)) ? 0 : (sizeof(T) <= sizeof(unsigned long)) ? 1 : 2>
+struct bit_builtins;
+
+template <typename T>
+struct bit_builtins<T, 0> {
+    static constexpr int width = bit_width_of<unsigned>::value;
+    static int popcount(T value) { return __builtin_popcount(value); }
+    static int ctz(T value) { return __builtin_ctz(value); }
+    static int clz(T value) { return __builtin_clz(value); }
+};
+
+template <typename T>
+struct bit_builtins<T, 1> {
+    static constexpr int width = bit_width_of<unsigned long>::value;
+    static int popcount(T value) { return __builtin_popcountl(value); }
+    static int ctz(T value) { return __builtin_ctzl(value); }
+    static int clz(T value) { return __builtin_clzl(value); }
+};
+
+template <typename T>
+struct bit_builtins<T, 2> {
+    static constexpr int width = bit_width_of<unsigned long long>::value;
+    static int popcount(T value) { return __builtin_popcountll(value); }
+    static int ctz(T value) { return __builtin_ctzll(value); }
+    static int clz(T value) { return __builtin_clzll(value); }
+};
+#endif
+
+template <typename T>
+struct is_bit_integer : std::integral_constant<bool,
+    std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value &&
+    sizeof(T) <= sizeof(uint64_t)> {};
+
+} // namespace detail
+
+// Number of set bits
+template <typename T>
+inline int popcount(T value) {
+    static_assert(detail::is_bit_integer<T>::value, "popcount requires an unsigned integer");
+#if defined(__GNUC__)
+    return detail::bit_builtins<T>::popcount(value);
+#else
+    return detail::swar_popcount(value);
+#endif
+}
+
+// Number of zero bits below the lowest set bit
+template <typename T>
+inline int countr_zero(T value) {
+    static_assert(detail::is_bit_integer<T>::value, "countr_zero requires an unsigned integer");
+#if defined(__GNUC__)
+    // Written so compilers can fold the zero case into TZCNT or RBIT+CLZ
+    return (value == 0) ? detail::bit_width_of<T>::value : detail::bit_builtins<T>::ctz(value);
+#else
+    return detail::swar_countr_zero(value, detail::bit_width_of<T>::value);
+#endif
+}
+
+// Number of zero bits above the highest set bit
+template <typename T>
+inline int countl_zero(T value) {
+    static_assert(detail::is_bit_integer<T>::value, "countl_zero requires an unsigned integer");
+#if defined(__GNUC__)
+    // The builtin counts in its own, possibly wider, argument type
+    return (value == 0) ? detail::bit_width_of<T>::value
+                        : detail::bit_builtins<T>::clz(value) -
+                              (detail::bit_builtins<T>::width - detail::bit_width_of<T>::value);
+#else
+    return detail::swar_countl_zero(value, detail::bit_width_of<T>::value);
+#endif
+}
+
+// Number of bits needed to represent value, 0 for 0
+template <typename T>
+inline int bit_width(T value) {
+    return detail::bit_width_of<T>::value - estl::countl_zero(value);
+}
+
+template <typename T>
+inline bool has_single_bit(T value) {
+    static_assert(detail::is_bit_integer<T>::value, "has_single_bit requires an unsigned integer");
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace estl
+
+#endif // ESTL_BIT_HPP
@@ -0,0 +1,642 @@
+#ifndef ESTL_BITSET_HPP
+#define ESTL_BITSET_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
+#include "bit.hpp"
+#include "memory.hpp"
+#include "overflow.hpp"
+#include "utility.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Bits are packed into native words: 32 bits on Cortex-M, 64 on 64-bit hosts
+using bit_word = uintptr_t;
+
+constexpr size_t bit_word_bits = sizeof(bit_word) * CHAR_BIT;
+
+// Words for bits bits; never zero, so even an empty set has an array
+constexpr size_t bit_word_count(size_t bits) {
+    return (bits == 0) ? 1 : (bits + bit_word_bits - 1) / bit_word_bits;
+}
+
+constexpr bit_word bit_mask(size_t pos) {
+    return static_cast<bit_word>(1) << (pos % bit_word_bits);
+}
+
+// The bits in use of the last of the words for bits bits
+constexpr bit_word bit_tail_mask(size_t bits) {
+    return (bits == 0) ? 0 : (bits % bit_word_bits == 0) ? ~static_cast<bit_word>(0) : bit_mask(bits) - 1;
+}
+
+/**
+ * Word-at-a-time bitmap kernels
+ *
+ * Shared by bitset and bit_vector, and usable on any array of bit_words.
+ * They rely on one invariant: the bits of the last word past bits are
+ * zero, so counts and scans need no mask at the end.
+ */
+
+// Sets or clears bits [first, last)
+inline void bits_assign(bit_word* words, size_t first, size_t last, bool value) {
+    if (first >= last) {
+        return;
+    }
+    size_t word = first / bit_word_bits;
+    size_t end = (last - 1) / bit_word_bits;
+    bit_word head = ~static_cast<bit_word>(0) << (first % bit_word_bits);
+    bit_word tail = ~static_cast<bit_word>(0) >> (bit_word_bits - 1 - (last - 1) % bit_word_bits);
+    if (word == end) {
+        head &= tail;
+    }
+    words[word] = value ? (words[word] | head) : (words[word] & ~head);
+    if (word == end) {
+        return;
+    }
+    for (++word; word < end; ++word) {
+        words[word] = value ? ~static_cast<bit_word>(0) : 0;
+    }
+    words[end] = value ? (words[end] | tail) : (words[end] & ~tail);
+}
+
+// Clears the bits of the last word past bits, restoring the invariant
+inline void bits_trim(bit_word* words, size_t bits) {
+    words[bit_word_count(bits) - 1] &= bit_tail_mask(bits);
+}
+
+inline size_t bits_count(const bit_word* words, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += static_cast<size_t>(estl::popcount(words[i]));
+    }
+    return total;
+}
+
+// The first set bit at or after pos, or bits if there is none
+inline size_t bits_find_set(const bit_word* words, size_t bits, size_t pos) {
+    if (pos >= bits) {
+        return bits;
+    }
+    size_t word = pos / bit_word_bits;
+    size_t count = bit_word_count(bits);
+    bit_word current = words[word] & (~static_cast<bit_word>(0) << (pos % bit_word_bits));
+    while (current == 0) {
+        if (++word == count) {
+            return bits;
+        }
+        current = words[word];
+    }
+    return word * bit_word_bits + static_cast<size_t>(estl::countr_zero(current));
+}
+
+// The first clear bit at or after pos, or bits if there is none
+inline size_t bits_find_unset(const bit_word* words, size_t bits, size_t pos) {
+    if (pos >= bits) {
+        return bits;
+    }
+    size_t word = pos / bit_word_bits;
+    size_t count = bit_word_count(bits);
+    bit_word current = ~words[word] & (~static_cast<bit_word>(0) << (pos % bit_word_bits));
+    while (current == 0) {
+        if (++word == count) {
+            return bits;
+        }
+        current = ~words[word];
+    }
+    // The trimmed bits of the last word read as clear
+    size_t found = word * bit_word_bits + static_cast<size_t>(estl::countr_zero(current));
+    return (found < bits) ? found : bits;
+}
+
+inline bool bits_equal(const bit_word* a, const bit_word* b, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Moves every bit shift places up, towards the last word
+inline void bits_shift_up(bit_word* words, size_t count, size_t shift) {
+    size_t word_shift = shift / bit_word_bits;
+    size_t bit_shift = shift % bit_word_bits;
+    if (word_shift >= count) {
+        word_shift = count;
+    }
+    for (size_t i = count; i-- > word_shift;) {
+        bit_word value = words[i - word_shift] << bit_shift;
+        if (bit_shift != 0 && i > word_shift) {
+            value |= words[i - word_shift - 1] >> (bit_word_bits - bit_shift);
+        }
+        words[i] = value;
+    }
+    for (size_t i = 0; i < word_shift; ++i) {
+        words[i] = 0;
+    }
+}
+
+// Moves every bit shift places down, towards the first word
+inline void bits_shift_down(bit_word* words, size_t count, size_t shift) {
+    size_t word_shift = shift / bit_word_bits;
+    size_t bit_shift = shift % bit_word_bits;
+    if (word_shift >= count) {
+        word_shift = count;
+    }
+    size_t kept = count - word_shift;
+    for (size_t i = 0; i < kept; ++i) {
+        bit_word value = words[i + word_shift] >> bit_shift;
+        if (bit_shift != 0 && i + 1 < kept) {
+            value |= words[i + word_shift + 1] << (bit_word_bits - bit_shift);
+        }
+        words[i] = value;
+    }
+    for (size_t i = kept; i < count; ++i) {
+        words[i] = 0;
+    }
+}
+
+// A bit of a bitset or bit_vector, as returned by the mutable operator[]
+class bit_reference {
+public:
+    bit_reference(bit_word& word, bit_word mask) : m_word(&word), m_mask(mask) {}
+
+    bit_reference& operator=(bool value) {
+        *m_word = value ? (*m_word | m_mask) : (*m_word & ~m_mask);
+        return *this;
+    }
+
+    bit_reference& operator=(const bit_reference& other) {
+        return *this = static_cast<bool>(other);
+    }
+
+    operator bool() const {
+        return (*m_word & m_mask) != 0;
+    }
+
+    bool operator~() const {
+        return (*m_word & m_mask) == 0;
+    }
+
+    bit_reference& flip() {
+        *m_word ^= m_mask;
+        return *this;
+    }
+
+private:
+    bit_word* m_word;
+    bit_word m_mask;
+};
+
+} // namespace detail
+
+/**
+ * @brief A fixed-size set of N bits
+ *
+ * std::bitset, packed into native words, with scans for the first set or
+ * clear bit that skip a whole word per step using the count-trailing-zeros
+ * instruction (see bit.hpp). This makes it the type for IRQ masks, slot
+ * occupancy and free lists: finding a free slot among 256 is eight word
+ * tests on Cortex-M instead of up to 256 byte tests over a bool array.
+ *
+ * The scans return size() when no bit qualifies. Positions out of range
+ * are caught by ESTL_ASSERT; there are no exceptions and no string
+ * conversions.
+ *
+ * @tparam N The number of bits
+ */
+template <size_t N>
+class bitset {
+    static constexpr size_t word_count = detail::bit_word_count(N);
+
+public:
+    // Type definitions
+    using size_type = size_t;
+    using word_type = detail::bit_word;
+    using reference = detail::bit_reference;
+
+    // Constructors
+    constexpr bitset() : m_words() {}
+
+    // The low bits of value; those past N are dropped
+    constexpr bitset(unsigned long long value) : bitset(value, detail::make_index_sequence<word_count>()) {}
+
+    // Element access
+    bool operator[](size_type pos) const {
+        return test(pos);
+    }
+
+    reference operator[](size_type pos) {
+        ESTL_ASSERT(pos < N);
+        return reference(m_words[pos / detail::bit_word_bits], detail::bit_mask(pos));
+    }
+
+    bool test(size_type pos) const {
+        ESTL_ASSERT(pos < N);
+        return (m_words[pos / detail::bit_word_bits] & detail::bit_mask(pos)) != 0;
+    }
+
+    bool all() const {
+        return detail::bits_find_unset(m_words, N, 0) == N;
+    }
+
+    bool any() const {
+        return detail::bits_find_set(m_words, N, 0) != N;
+    }
+
+    bool none() const {
+        return !any();
+    }
+
+    size_type count() const {
+        return detail::bits_count(m_words, word_count);
+    }
+
+    static constexpr size_type size() {
+        return N;
+    }
+
+    // Scans; each returns size() when no bit qualifies
+    size_type find_first_set() const {
+        return detail::bits_find_set(m_words, N, 0);
+    }
+
+    // The first set bit after pos
+    size_type find_next(size_type pos) const {
+        return detail::bits_find_set(m_words, N, pos + 1);
+    }
+
+    size_type find_first_unset() const {
+        return detail::bits_find_unset(m_words, N, 0);
+    }
+
+    // The first clear bit after pos
+    size_type find_next_unset(size_type pos) const {
+        return detail::bits_find_unset(m_words, N, pos + 1);
+    }
+
+    // Modifiers
+    bitset& set() {
+        detail::bits_assign(m_words, 0, N, true);
+        return *this;
+    }
+
+    bitset& set(size_type pos, bool value = true) {
+        (*this)[pos] = value;
+        return *this;
+    }
+
+    bitset& reset() {
+        for (size_t i = 0; i < word_count; ++i) {
+            m_words[i] = 0;
+        }
+        return *this;
+    }
+
+    bitset& reset(size_type pos) {
+        return set(pos, false);
+    }
+
+    bitset& flip() {
+        for (size_t i = 0; i < word_count; ++i) {
+            m_words[i] = ~m_words[i];
+        }
+        detail::bits_trim(m_words, N);
+        return *this;
+    }
+
+    bitset& flip(size_type pos) {
+        (*this)[pos].flip();
+        return *this;
+    }
+
+    // Bitwise operators
+    bitset& operator&=(const bitset& other) {
+        for (size_t i = 0; i < word_count; ++i) {
+            m_words[i] &= other.m_words[i];
+        }
+        return *this;
+    }
+
+    bitset& operator|=(const bitset& other) {
+        for (size_t i = 0; i < word_count; ++i) {
+            m_words[i] |= other.m_words[i];
+        }
+        return *this;
+    }
+
+    bitset& operator^=(const bitset& other) {
+        for (size_t i = 0; i < word_count; ++i) {
+            m_words[i] ^= other.m_words[i];
+        }
+        return *this;
+    }
+
+    bitset& operator<<=(size_type shift) {
+        detail::bits_shift_up(m_words, word_count, shift);
+        detail::bits_trim(m_words, N);
+        return *this;
+    }
+
+    bitset& operator>>=(size_type shift) {
+        detail::bits_shift_down(m_words, word_count, shift);
+        return *this;
+    }
+
+    bitset operator~() const {
+        return bitset(*this).flip();
+    }
+
+    bitset operator<<(size_type shift) const {
+        return bitset(*this) <<= shift;
+    }
+
+    bitset operator>>(size_type shift) const {
+        return bitset(*this) >>= shift;
+    }
+
+    bool operator==(const bitset& other) const {
+        return detail::bits_equal(m_words, other.m_words, word_count);
+    }
+
+    bool operator!=(const bitset& other) const {
+        return !(*this == other);
+    }
+
+    // The bits as an integer; they must all fit
+    unsigned long long to_ullong() const {
+        unsigned long long value = 0;
+        for (size_t i = 0; i < word_count; ++i) {
+            if (i * detail::bit_word_bits < 64) {
+                value |= static_cast<unsigned long long>(m_words[i]) << (i * detail::bit_word_bits);
+            } else {
+                ESTL_ASSERT(m_words[i] == 0);
+            }
+        }
+        return value;
+    }
+
+    // The packed words, bit 0 first, for the detail::bits_* kernels
+    const word_type* data() const {
+        return m_words;
+    }
+
+private:
+    template <size_t... I>
+    constexpr bitset(unsigned long long value, detail::index_sequence<I...>)
+        : m_words{ word_of(value, I)... } {}
+
+    static constexpr word_type word_of(unsigned long long value, size_t index) {
+        return (index * detail::bit_word_bits >= 64)
+            ? 0
+            : static_cast<word_type>(value >> (index * detail::bit_word_bits)) &
+                  ((index + 1 == word_count) ? detail::bit_tail_mask(N) : ~static_cast<word_type>(0));
+    }
+
+    word_type m_words[word_count];
+};
+
+template <size_t N>
+constexpr size_t bitset<N>::word_count;
+
+template <size_t N>
+bitset<N> operator&(const bitset<N>& lhs, const bitset<N>& rhs) {
+    return bitset<N>(lhs) &= rhs;
+}
+
+template <size_t N>
+bitset<N> operator|(const bitset<N>& lhs, const bitset<N>& rhs) {
+    return bitset<N>(lhs) |= rhs;
+}
+
+template <size_t N>
+bitset<N> operator^(const bitset<N>& lhs, const bitset<N>& rhs) {
+    return bitset<N>(lhs) ^= rhs;
+}
+
+/**
+ * @brief A sequence of up to Capacity bits, packed into words
+ *
+ * The replacement for estl::vector<bool, Capacity>, which spends a byte per
+ * flag: the storage is Capacity / 8 bytes rounded up to a word, count() is
+ * a popcount per word and the scans are those of bitset. There are no
+ * iterators; loop over indices, or over the set bits with find_first_set()
+ * and find_next().
+ *
+ * A push_back() into a full bit_vector asserts and is ignored, as with
+ * vector's default overflow policy; try_push_back() reports it instead.
+ *
+ * @tparam Capacity The maximum number of bits
+ */
+template <size_t Capacity>
+class bit_vector {
+    static constexpr size_t word_count = detail::bit_word_count(Capacity);
+
+public:
+    // Type definitions
+    using size_type = size_t;
+    using word_type = detail::bit_word;
+    using reference = detail::bit_reference;
+
+    // Constructors
+    constexpr bit_vector() : m_words(), m_size(0) {}
+
+    explicit bit_vector(size_type count, bool value = false) : m_words(), m_size(0) {
+        resize(count, value);
+    }
+
+    // Element access
+    bool operator[](size_type pos) const {
+        return test(pos);
+    }
+
+    reference operator[](size_type pos) {
+        ESTL_ASSERT(pos < m_size);
+        return reference(m_words[pos / detail::bit_word_bits], detail::bit_mask(pos));
+    }
+
+    bool test(size_type pos) const {
+        ESTL_ASSERT(pos < m_size);
+        return (m_words[pos / detail::bit_word_bits] & detail::bit_mask(pos)) != 0;
+    }
+
+    bool front() const {
+        return test(0);
+    }
+
+    bool back() const {
+        return test(m_size - 1);
+    }
+
+    bool all() const {
+        return detail::bits_find_unset(m_words, m_size, 0) == m_size;
+    }
+
+    bool any() const {
+        return detail::bits_find_set(m_words, m_size, 0) != m_size;
+    }
+
+    bool none() const {
+        return !any();
+    }
+
+    size_type count() const {
+        return detail::bits_count(m_words, used_words());
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    bool full() const {
+        return m_size == Capacity;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    static constexpr size_type capacity() {
+        return Capacity;
+    }
+
+    static constexpr size_type max_size() {
+        return Capacity;
+    }
+
+    // Scans; each returns size() when no bit qualifies
+    size_type find_first_set() const {
+        return detail::bits_find_set(m_words, m_size, 0);
+    }
+
+    // The first set bit after pos
+    size_type find_next(size_type pos) const {
+        return detail::bits_find_set(m_words, m_size, pos + 1);
+    }
+
+    size_type find_first_unset() const {
+        return detail::bits_find_unset(m_words, m_size, 0);
+    }
+
+    // The first clear bit after pos
+    size_type find_next_unset(size_type pos) const {
+        return detail::bits_find_unset(m_words, m_size, pos + 1);
+    }
+
+    // Modifiers
+    void push_back(bool value) {
+        if (!try_push_back(value)) {
+            overflow_assert::on_overflow();
+        }
+    }
+
+    bool try_push_back(bool value) {
+        if (full()) {
+            return false;
+        }
+        if (value) {
+            m_words[m_size / detail::bit_word_bits] |= detail::bit_mask(m_size);
+        }
+        ++m_size;
+        return true;
+    }
+
+    void pop_back() {
+        ESTL_ASSERT(m_size > 0);
+        --m_size;
+        m_words[m_size / detail::bit_word_bits] &= ~detail::bit_mask(m_size);
+    }
+
+    // New bits take value; the size is limited to Capacity
+    void resize(size_type count, bool value = false) {
+        if (count > Capacity) {
+            count = Capacity;
+        }
+        if (count > m_size) {
+            detail::bits_assign(m_words, m_size, count, value);
+        } else {
+            detail::bits_assign(m_words, count, m_size, false);
+        }
+        m_size = static_cast<size_type_storage>(count);
+    }
+
+    void assign(size_type count, bool value) {
+        clear();
+        resize(count, value);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < used_words(); ++i) {
+            m_words[i] = 0;
+        }
+        m_size = 0;
+    }
+
+    bit_vector& set() {
+        detail::bits_assign(m_words, 0, m_size, true);
+        return *this;
+    }
+
+    bit_vector& set(size_type pos, bool value = true) {
+        (*this)[pos] = value;
+        return *this;
+    }
+
+    bit_vector& reset() {
+        detail::bits_assign(m_words, 0, m_size, false);
+        return *this;
+    }
+
+    bit_vector& reset(size_type pos) {
+        return set(pos, false);
+    }
+
+    bit_vector& flip() {
+        for (size_t i = 0; i < used_words(); ++i) {
+            m_words[i] = ~m_words[i];
+        }
+        detail::bits_trim(m_words, m_size);
+        return *this;
+    }
+
+    bit_vector& flip(size_type pos) {
+        (*this)[pos].flip();
+        return *this;
+    }
+
+    bool operator==(const bit_vector& other) const {
+        return m_size == other.m_size && detail::bits_equal(m_words, other.m_words, used_words());
+    }
+
+    bool operator!=(const bit_vector& other) const {
+        return !(*this == other);
+    }
+
+    // The packed words, bit 0 first, for the detail::bits_* kernels
+    const word_type* data() const {
+        return m_words;
+    }
+
+private:
+    using size_type_storage = typename detail::capacity_size_type<Capacity>::type;
+
+    // Words holding at least one bit; those after them are all zero
+    size_t used_words() const {
+        return (m_size + detail::bit_word_bits - 1) / detail::bit_word_bits;
+    }
+
+    word_type m_words[word_count];
+    size_type_storage m_size;
+};
+
+template <size_t Capacity>
+constexpr size_t bit_vector<Capacity>::word_count;
+
+} // namespace estl
+
+#endif // ESTL_BITSET_HPP
@@ -0,0 +1,1383 @@
+#ifndef ESTL_BTREE_MAP_HPP
+#define ESTL_BTREE_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+#include "overflow.hpp"
+#include "stats.hpp"
+#include "map.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Default fan-out: as many elements as fill a leaf of two cache lines
+// along with its count and links, within [4, 64]
+template <typename Key, typename T, size_t Capacity>
+struct btree_node_size {
+    static constexpr size_t leaf_bytes = 2 * ESTL_CACHE_LINE_SIZE;
+    static constexpr size_t header_bytes = 4 * sizeof(typename capacity_size_type<Capacity>::type);
+    static constexpr size_t fit = (leaf_bytes > header_bytes)
+        ? (leaf_bytes - header_bytes) / sizeof(std::pair<const Key, T>) : 0;
+    static constexpr size_t value = (fit < 4) ? 4 : (fit > 64) ? 64 : fit;
+};
+
+// Upper bound on the inner nodes above count nodes, when every inner node
+// but the root has at least min_children children
+constexpr size_t btree_inner_bound(size_t count, size_t min_children) {
+    return (count <= 1) ? 0
+        : (count + min_children - 1) / min_children +
+              btree_inner_bound((count + min_children - 1) / min_children, min_children);
+}
+
+// Moves count live elements from src to raw storage at dst; src is left raw
+template <typename T>
+void btree_relocate(T* src, size_t count, T* dst) {
+    estl::uninitialized_move(src, src + count, dst);
+    estl::destroy(src, src + count);
+}
+
+// Exchanges the a_count live elements at a with the b_count at b. Elements
+// are swapped by reconstruction, as keys in a pair<const Key, T> cannot be
+// assigned.
+template <typename T>
+void btree_swap_elements(T* a, size_t a_count, T* b, size_t b_count) {
+    size_t common = (a_count < b_count) ? a_count : b_count;
+    for (size_t i = 0; i < common; ++i) {
+        T temp(std::move(a[i]));
+        a[i].~T();
+        new (&a[i]) T(std::move(b[i]));
+        b[i].~T();
+        new (&b[i]) T(std::move(temp));
+    }
+    if (a_count > common) {
+        btree_relocate(a + common, a_count - common, b + common);
+    } else if (b_count > common) {
+        btree_relocate(b + common, b_count - common, a + common);
+    }
+}
+
+// The node pool of a btree_map. Nodes are linked by index rather than by
+// pointer, so a tree can be copied or swapped slot by slot. Indices start
+// at 1, leaving 0 for no node, so an empty tree is all zeros and static maps
+// are constant-initialized into .bss. Nodes that were never handed out are
+// taken in index order and freed ones are kept on a free list, as in
+// estl::pool.
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+struct btree_nodes_base {
+    using value_type = std::pair<const Key, T>;
+
+    // Nodes other than the root are kept at least half full
+    static constexpr size_t min_fill = NodeSize / 2;
+    static constexpr size_t leaf_count = Capacity / min_fill + 1;
+    static constexpr size_t inner_count = (btree_inner_bound(leaf_count, min_fill) > 0)
+        ? btree_inner_bound(leaf_count, min_fill) : 1;
+
+    using node_index = typename capacity_size_type<(leaf_count > inner_count) ? leaf_count : inner_count>::type;
+    using count_type = typename capacity_size_type<NodeSize + 1>::type;
+
+    static constexpr node_index none = 0;
+    static constexpr size_t leaf_align = (ESTL_CACHE_LINE_SIZE > alignof(value_type))
+        ? ESTL_CACHE_LINE_SIZE : alignof(value_type);
+    static constexpr size_t inner_align = (ESTL_CACHE_LINE_SIZE > alignof(Key))
+        ? ESTL_CACHE_LINE_SIZE : alignof(Key);
+
+    // Holds the elements, in key order; leaves form a doubly linked list
+    struct alignas(leaf_align) leaf_node {
+        constexpr leaf_node() : m_values(), m_count(0), m_parent(none), m_prev(none), m_next(none) {}
+
+        value_type* values() {
+            return reinterpret_cast<value_type*>(m_values.m_bytes);
+        }
+
+        const value_type* values() const {
+            return reinterpret_cast<const value_type*>(m_values.m_bytes);
+        }
+
+        inline_storage<value_type, NodeSize> m_values;
+        count_type m_count;
+        node_index m_parent;
+        node_index m_prev;
+        node_index m_next;
+    };
+
+    // m_count children and m_count - 1 separating keys: every key under
+    // child i + 1 is at least keys()[i] and every key under child i is
+    // below it. Both arrays have a spare slot for the split that follows an
+    // insertion into a full node.
+    struct alignas(inner_align) inner_node {
+        constexpr inner_node() : m_keys(), m_children(), m_count(0), m_parent(none) {}
+
+        Key* keys() {
+            return reinterpret_cast<Key*>(m_keys.m_bytes);
+        }
+
+        const Key* keys() const {
+            return reinterpret_cast<const Key*>(m_keys.m_bytes);
+        }
+
+        inline_storage<Key, NodeSize> m_keys;
+        node_index m_children[NodeSize + 1];
+        count_type m_count;
+        node_index m_parent;
+    };
+
+    constexpr btree_nodes_base()
+        : m_leaves(), m_inners(), m_root(none), m_first(none), m_last(none), m_free_leaf(none),
+          m_free_inner(none), m_untouched_leaves(0), m_untouched_inners(0), m_height(0), m_size(0) {}
+
+    leaf_node& leaf(node_index index) {
+        return m_leaves[index - 1];
+    }
+
+    const leaf_node& leaf(node_index index) const {
+        return m_leaves[index - 1];
+    }
+
+    inner_node& inner(node_index index) {
+        return m_inners[index - 1];
+    }
+
+    const inner_node& inner(node_index index) const {
+        return m_inners[index - 1];
+    }
+
+    // The pool is sized for Capacity elements, so allocation cannot fail
+    node_index allocate_leaf() {
+        node_index index = m_free_leaf;
+        if (index != none) {
+            m_free_leaf = leaf(index).m_next;
+        } else {
+            ESTL_ASSERT(m_untouched_leaves < leaf_count);
+            index = ++m_untouched_leaves;
+        }
+        leaf_node& node = leaf(index);
+        node.m_count = 0;
+        node.m_parent = node.m_prev = node.m_next = none;
+        return index;
+    }
+
+    void free_leaf(node_index index) {
+        leaf(index).m_count = 0;
+        leaf(index).m_next = m_free_leaf;
+        m_free_leaf = index;
+    }
+
+    node_index allocate_inner() {
+        node_index index = m_free_inner;
+        if (index != none) {
+            m_free_inner = inner(index).m_parent;
+        } else {
+            ESTL_ASSERT(m_untouched_inners < inner_count);
+            index = ++m_untouched_inners;
+        }
+        inner(index).m_count = 0;
+        inner(index).m_parent = none;
+        return index;
+    }
+
+    void free_inner(node_index index) {
+        inner(index).m_count = 0;
+        inner(index).m_parent = m_free_inner;
+        m_free_inner = index;
+    }
+
+    // Destroys every element and key and returns all nodes to the pool.
+    // Free nodes have a zero count, so only the nodes ever handed out need
+    // to be visited; they are left with a zero count too, as swap() expects
+    // of every node past the ones in use.
+    void destroy_nodes() {
+        for (size_t i = 0; i < m_untouched_leaves; ++i) {
+            estl::destroy(m_leaves[i].values(), m_leaves[i].values() + m_leaves[i].m_count);
+            m_leaves[i].m_count = 0;
+        }
+        for (size_t i = 0; i < m_untouched_inners; ++i) {
+            if (m_inners[i].m_count > 0) {
+                estl::destroy(m_inners[i].keys(), m_inners[i].keys() + (m_inners[i].m_count - 1));
+            }
+            m_inners[i].m_count = 0;
+        }
+        m_root = m_first = m_last = m_free_leaf = m_free_inner = none;
+        m_untouched_leaves = m_untouched_inners = 0;
+        m_height = 0;
+        m_size = 0;
+    }
+
+    leaf_node m_leaves[leaf_count];
+    inner_node m_inners[inner_count];
+    node_index m_root;
+    node_index m_first;
+    node_index m_last;
+    node_index m_free_leaf;
+    node_index m_free_inner;
+    node_index m_untouched_leaves;
+    node_index m_untouched_inners;
+    // Number of inner levels above the leaves
+    uint8_t m_height;
+    typename capacity_size_type<Capacity>::type m_size;
+};
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+constexpr size_t btree_nodes_base<Key, T, Capacity, NodeSize>::min_fill;
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+constexpr size_t btree_nodes_base<Key, T, Capacity, NodeSize>::leaf_count;
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+constexpr size_t btree_nodes_base<Key, T, Capacity, NodeSize>::inner_count;
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+constexpr typename btree_nodes_base<Key, T, Capacity, NodeSize>::node_index
+    btree_nodes_base<Key, T, Capacity, NodeSize>::none;
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+constexpr size_t btree_nodes_base<Key, T, Capacity, NodeSize>::leaf_align;
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+constexpr size_t btree_nodes_base<Key, T, Capacity, NodeSize>::inner_align;
+
+// Only element and key types that need it get a destructor, so maps of
+// trivially destructible types stay trivially destructible
+template <typename Key, typename T, size_t Capacity, size_t NodeSize,
+          bool = std::is_trivially_destructible<Key>::value && std::is_trivially_destructible<T>::value>
+struct btree_nodes : btree_nodes_base<Key, T, Capacity, NodeSize> {
+    constexpr btree_nodes() : btree_nodes_base<Key, T, Capacity, NodeSize>() {}
+};
+
+template <typename Key, typename T, size_t Capacity, size_t NodeSize>
+struct btree_nodes<Key, T, Capacity, NodeSize, false> : btree_nodes_base<Key, T, Capacity, NodeSize> {
+    constexpr btree_nodes() : btree_nodes_base<Key, T, Capacity, NodeSize>() {}
+
+    ~btree_nodes() {
+        this->destroy_nodes();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A sorted associative container kept in a B+ tree
+ *
+ * estl::map keeps its elements in one sorted array, so an insert or erase
+ * shifts every element behind it: O(N), which dominates for tables of
+ * thousands of entries. btree_map keeps them in leaves of at most NodeSize
+ * elements under inner nodes of separating keys, so insert and erase move
+ * at most NodeSize elements per level and cost O(log N); lookups read one
+ * node per level. The interface is that of estl::map, so either can back a
+ * given table.
+ *
+ * The nodes come from a pool inside the object, sized at compile time for
+ * Capacity elements with every node but the root at least half full; nothing
+ * is allocated. That worst case takes two to three times the storage of an
+ * estl::map. Nodes are cache-line aligned and the default NodeSize makes a
+ * leaf two cache lines. Inner nodes hold copies of keys, so Key must be
+ * copyable.
+ *
+ * Iteration walks the linked leaves. As with estl::map, insertions and
+ * erasures invalidate iterators; erase returns the iterator that follows.
+ *
+ * @tparam Key The type of keys
+ * @tparam T The type of mapped values
+ * @tparam Compare The comparison function object type, stateless
+ * @tparam Capacity The maximum number of elements
+ * @tparam NodeSize The maximum number of elements per leaf and children per inner node
+ * @tparam Overflow What insertions into a full map do (see overflow_assert)
+ */
+template <
+    typename Key,
+    typename T,
+    typename Compare = less<Key>,
+    size_t Capacity = 64,
+    size_t NodeSize = detail::btree_node_size<Key, T, Capacity>::value,
+    typename Overflow = overflow_assert
+>
+class btree_map : private detail::btree_nodes<Key, T, Capacity, NodeSize>, private detail::stats_base {
+    static_assert(Capacity > 0, "btree_map Capacity must not be zero");
+    static_assert(NodeSize >= 4, "btree_map NodeSize must be at least 4");
+
+    using node_base = detail::btree_nodes<Key, T, Capacity, NodeSize>;
+    using stats_base = detail::stats_base;
+    using typename node_base::node_index;
+    using typename node_base::leaf_node;
+    using typename node_base::inner_node;
+    using node_base::none;
+    using node_base::min_fill;
+    using node_base::leaf;
+    using node_base::inner;
+    using node_base::allocate_leaf;
+    using node_base::free_leaf;
+    using node_base::allocate_inner;
+    using node_base::free_inner;
+    using node_base::destroy_nodes;
+    using node_base::m_root;
+    using node_base::m_first;
+    using node_base::m_last;
+    using node_base::m_height;
+    using node_base::m_size;
+    using stats_base::record_size;
+    using stats_base::record_insert;
+    using stats_base::record_erase;
+    using stats_base::record_find;
+    using stats_base::record_overflow;
+
+public:
+    // Type definitions
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using key_compare = Compare;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    // An element is a leaf and a slot in it
+    class iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        iterator() : m_tree(nullptr), m_leaf(0), m_slot(0) {}
+        iterator(btree_map* tree, node_index leaf, size_type slot) : m_tree(tree), m_leaf(leaf), m_slot(slot) {}
+
+        reference operator*() const {
+            return m_tree->leaf(m_leaf).values()[m_slot];
+        }
+
+        pointer operator->() const {
+            return &(m_tree->leaf(m_leaf).values()[m_slot]);
+        }
+
+        iterator& operator++() {
+            m_tree->advance(m_leaf, m_slot);
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        iterator& operator--() {
+            m_tree->retreat(m_leaf, m_slot);
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return m_tree == other.m_tree && m_leaf == other.m_leaf && m_slot == other.m_slot;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        btree_map* m_tree;
+        node_index m_leaf;
+        size_type m_slot;
+
+        friend class btree_map;
+        friend class const_iterator;
+    };
+
+    class const_iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = const std::pair<const Key, T>;
+        using difference_type = ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() : m_tree(nullptr), m_leaf(0), m_slot(0) {}
+        const_iterator(const btree_map* tree, node_index leaf, size_type slot)
+            : m_tree(tree), m_leaf(leaf), m_slot(slot) {}
+        const_iterator(const iterator& it) : m_tree(it.m_tree), m_leaf(it.m_leaf), m_slot(it.m_slot) {}
+
+        reference operator*() const {
+            return m_tree->leaf(m_leaf).values()[m_slot];
+        }
+
+        pointer operator->() const {
+            return &(m_tree->leaf(m_leaf).values()[m_slot]);
+        }
+
+        const_iterator& operator++() {
+            m_tree->advance(m_leaf, m_slot);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator& operator--() {
+            m_tree->retreat(m_leaf, m_slot);
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_tree == other.m_tree && m_leaf == other.m_leaf && m_slot == other.m_slot;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const btree_map* m_tree;
+        node_index m_leaf;
+        size_type m_slot;
+
+        friend class btree_map;
+    };
+
+    using reverse_iterator = estl::reverse_iterator<iterator>;
+    using const_reverse_iterator = estl::reverse_iterator<const_iterator>;
+
+    // Value compare helper class
+    class value_compare {
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    };
+
+    // Constructors
+    constexpr btree_map() : node_base(), stats_base(this, "btree_map", Capacity) {}
+
+    btree_map(const btree_map& other) : node_base(), stats_base(this, "btree_map", Capacity) {
+        copy_nodes(other);
+    }
+
+    template <typename InputIt>
+    btree_map(InputIt first, InputIt last) : node_base(), stats_base(this, "btree_map", Capacity) {
+        insert(first, last);
+    }
+
+    btree_map(std::initializer_list<value_type> init) : node_base(), stats_base(this, "btree_map", Capacity) {
+        insert(init.begin(), init.end());
+    }
+
+    // The input is trusted to be sorted and unique (checked by ESTL_ASSERT
+    // only), so every element is appended at end() without a search
+    template <typename InputIt>
+    btree_map(sorted_unique_t, InputIt first, InputIt last) : node_base(), stats_base(this, "btree_map", Capacity) {
+        for (; first != last; ++first) {
+            ESTL_ASSERT(m_size == 0 || key_comp()(rbegin()->first, first->first));
+            insert(cend(), *first);
+        }
+    }
+
+    btree_map(sorted_unique_t, std::initializer_list<value_type> init)
+        : btree_map(sorted_unique, init.begin(), init.end()) {}
+
+    // Assignment operator
+    btree_map& operator=(const btree_map& other) {
+        if (this != &other) {
+            clear();
+            copy_nodes(other);
+        }
+        return *this;
+    }
+
+    // Element access
+    T& at(const Key& key) {
+        iterator it = find(key);
+        ESTL_ASSERT(it != end());
+        return it->second;
+    }
+
+    const T& at(const Key& key) const {
+        const_iterator it = find(key);
+        ESTL_ASSERT(it != end());
+        return it->second;
+    }
+
+    // One search; a new element is value-initialized in its final slot.
+    // A new key needs room (or an evicting Overflow policy), asserted like
+    // the key of at(); try_emplace reports a rejected one instead.
+    T& operator[](const Key& key) {
+        return mapped_or_assert(try_emplace(key).first);
+    }
+
+    T& operator[](Key&& key) {
+        return mapped_or_assert(try_emplace(std::move(key)).first);
+    }
+
+    // Iterators
+    iterator begin() {
+        return iterator(this, m_first, 0);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, m_first, 0);
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    iterator end() {
+        return iterator(this, m_last, end_slot());
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, m_last, end_slot());
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    size_type max_size() const {
+        return Capacity;
+    }
+
+    // Modifiers
+    void clear() {
+        destroy_nodes();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_unique(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_unique(std::move(value));
+    }
+
+    // No search when hint is the insert position, so inserting ascending
+    // keys at end() costs no more than the splits
+    iterator insert(const_iterator hint, const value_type& value) {
+        return insert_hinted(hint, value);
+    }
+
+    iterator insert(const_iterator hint, value_type&& value) {
+        return insert_hinted(hint, std::move(value));
+    }
+
+    // The element is built before the search, since only it knows its key;
+    // prefer try_emplace when the key is at hand
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert_unique(value_type(std::forward<Args>(args)...));
+    }
+
+    // Searches once and, only if key is absent, constructs the mapped value
+    // from args directly in its final slot
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return try_emplace_key(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        return try_emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator hint, const Key& key, Args&&... args) {
+        return try_emplace_hinted(hint, key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator hint, Key&& key, Args&&... args) {
+        return try_emplace_hinted(hint, std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Assigns obj to the mapped value of key, inserting it if absent
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        return insert_or_assign_key(key, std::forward<M>(obj));
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        return insert_or_assign_key(std::move(key), std::forward<M>(obj));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return insert_hinted(hint, value_type(std::forward<Args>(args)...));
+    }
+
+    // One O(log N) insertion per element: unlike estl::map there is no
+    // shifting for a batch to amortize
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase_at(pos.m_leaf, pos.m_slot);
+    }
+
+    size_type erase(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    // Exchanges the contents node slot by node slot; the links are indices,
+    // so they stay valid in the other map. O(number of nodes in use).
+    void swap(btree_map& other) {
+        size_t leaves = (this->m_untouched_leaves > other.m_untouched_leaves) ? this->m_untouched_leaves
+                                                                              : other.m_untouched_leaves;
+        for (size_t i = 1; i <= leaves; ++i) {
+            leaf_node& a = leaf(static_cast<node_index>(i));
+            leaf_node& b = other.leaf(static_cast<node_index>(i));
+            detail::btree_swap_elements(a.values(), a.m_count, b.values(), b.m_count);
+            swap_fields(a.m_count, b.m_count);
+            swap_fields(a.m_parent, b.m_parent);
+            swap_fields(a.m_prev, b.m_prev);
+            swap_fields(a.m_next, b.m_next);
+        }
+        size_t inners = (this->m_untouched_inners > other.m_untouched_inners) ? this->m_untouched_inners
+                                                                              : other.m_untouched_inners;
+        for (size_t i = 1; i <= inners; ++i) {
+            inner_node& a = inner(static_cast<node_index>(i));
+            inner_node& b = other.inner(static_cast<node_index>(i));
+            detail::btree_swap_elements(a.keys(), key_count(a), b.keys(), key_count(b));
+            for (size_t c = 0; c <= NodeSize; ++c) {
+                swap_fields(a.m_children[c], b.m_children[c]);
+            }
+            swap_fields(a.m_count, b.m_count);
+            swap_fields(a.m_parent, b.m_parent);
+        }
+        swap_fields(m_root, other.m_root);
+        swap_fields(m_first, other.m_first);
+        swap_fields(m_last, other.m_last);
+        swap_fields(this->m_free_leaf, other.m_free_leaf);
+        swap_fields(this->m_free_inner, other.m_free_inner);
+        swap_fields(this->m_untouched_leaves, other.m_untouched_leaves);
+        swap_fields(this->m_untouched_inners, other.m_untouched_inners);
+        swap_fields(m_height, other.m_height);
+        swap_fields(m_size, other.m_size);
+        record_size(m_size);
+        other.record_size(other.m_size);
+    }
+
+    // Lookup
+    size_type count(const Key& key) const {
+        return (find(key) != end()) ? 1 : 0;
+    }
+
+    iterator find(const Key& key) {
+        record_find();
+        node_index node;
+        size_type slot;
+        return search(key, node, slot) ? iterator(this, node, slot) : end();
+    }
+
+    const_iterator find(const Key& key) const {
+        record_find();
+        node_index node;
+        size_type slot;
+        return search(key, node, slot) ? const_iterator(this, node, slot) : end();
+    }
+
+    std::pair<iterator, iterator> equal_range(const Key& key) {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    iterator lower_bound(const Key& key) {
+        node_index node;
+        size_type slot;
+        search(key, node, slot);
+        normalize(node, slot);
+        return iterator(this, node, slot);
+    }
+
+    const_iterator lower_bound(const Key& key) const {
+        node_index node;
+        size_type slot;
+        search(key, node, slot);
+        normalize(node, slot);
+        return const_iterator(this, node, slot);
+    }
+
+    iterator upper_bound(const Key& key) {
+        node_index node;
+        size_type slot;
+        search_upper(key, node, slot);
+        return iterator(this, node, slot);
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        node_index node;
+        size_type slot;
+        search_upper(key, node, slot);
+        return const_iterator(this, node, slot);
+    }
+
+    // Observers
+    key_compare key_comp() const {
+        return Compare();
+    }
+
+    value_compare value_comp() const {
+        return value_compare(Compare());
+    }
+
+private:
+    T& mapped_or_assert(iterator it) {
+        ESTL_ASSERT(it != end() && "operator[] on a full map");
+        return it->second;
+    }
+
+    template <typename U>
+    static void swap_fields(U& a, U& b) {
+        U temp = a;
+        a = b;
+        b = temp;
+    }
+
+    static size_type key_count(const inner_node& node) {
+        return (node.m_count > 0) ? node.m_count - 1 : 0;
+    }
+
+    size_type end_slot() const {
+        return (m_last == none) ? 0 : leaf(m_last).m_count;
+    }
+
+    void advance(node_index& node, size_type& slot) const {
+        ++slot;
+        normalize(node, slot);
+    }
+
+    void retreat(node_index& node, size_type& slot) const {
+        if (slot == 0) {
+            node = leaf(node).m_prev;
+            slot = leaf(node).m_count;
+        }
+        --slot;
+    }
+
+    // Moves a position past the end of a leaf to the start of the next one;
+    // only the last leaf's end stays, as end()
+    void normalize(node_index& node, size_type& slot) const {
+        if (node != none && slot == leaf(node).m_count && leaf(node).m_next != none) {
+            node = leaf(node).m_next;
+            slot = 0;
+        }
+    }
+
+    // Descends to the leaf whose key range holds key. Nodes are short, so
+    // they are scanned linearly: cheaper than a binary search's
+    // unpredictable branches.
+    node_index leaf_for(const Key& key) const {
+        node_index node = m_root;
+        for (size_t level = m_height; level > 0; --level) {
+            const inner_node& parent = inner(node);
+            const Key* keys = parent.keys();
+            size_type child = 0;
+            size_type count = parent.m_count - 1;
+            while (child < count && !key_comp()(key, keys[child])) {
+                ++child;
+            }
+            node = parent.m_children[child];
+        }
+        return node;
+    }
+
+    // Sets node and slot to where key is or would be inserted; the slot may
+    // be one past the end of its leaf. Returns true when key is present.
+    bool search(const Key& key, node_index& node, size_type& slot) const {
+        if (m_root == none) {
+            node = none;
+            slot = 0;
+            return false;
+        }
+        node = leaf_for(key);
+        const value_type* values = leaf(node).values();
+        size_type count = leaf(node).m_count;
+        slot = 0;
+        while (slot < count && key_comp()(values[slot].first, key)) {
+            ++slot;
+        }
+        return slot < count && !key_comp()(key, values[slot].first);
+    }
+
+    void search_upper(const Key& key, node_index& node, size_type& slot) const {
+        if (m_root == none) {
+            node = none;
+            slot = 0;
+            return;
+        }
+        node = leaf_for(key);
+        const value_type* values = leaf(node).values();
+        size_type count = leaf(node).m_count;
+        slot = 0;
+        while (slot < count && !key_comp()(key, values[slot].first)) {
+            ++slot;
+        }
+        normalize(node, slot);
+    }
+
+    // Sets node and slot for key, trying hint before searching. Returns true
+    // when key is already present there.
+    bool locate(const_iterator hint, const Key& key, node_index& node, size_type& slot) const {
+        node = hint.m_leaf;
+        slot = hint.m_slot;
+        if (node != none) {
+            const leaf_node& target = leaf(node);
+            // The start of a leaf other than the first may lie beyond its
+            // separator, so only positions inside a leaf are taken as is
+            bool before = (slot == target.m_count) || key_comp()(key, target.values()[slot].first);
+            bool after = (slot > 0) ? key_comp()(target.values()[slot - 1].first, key) : target.m_prev == none;
+            if (before && after) {
+                return false;
+            }
+        }
+        return search(key, node, slot);
+    }
+
+    void set_parent(node_index node, bool is_leaf, node_index parent) {
+        if (is_leaf) {
+            leaf(node).m_parent = parent;
+        } else {
+            inner(node).m_parent = parent;
+        }
+    }
+
+    node_index parent_of(node_index node, bool is_leaf) const {
+        return is_leaf ? leaf(node).m_parent : inner(node).m_parent;
+    }
+
+    static size_type child_slot(const inner_node& parent, node_index child) {
+        size_type slot = 0;
+        while (parent.m_children[slot] != child) {
+            ++slot;
+        }
+        return slot;
+    }
+
+    // Constructs a new element at slot of node, the position for its key,
+    // if there is room, or as the overflow policy prescribes; node and slot
+    // are updated to where it went. Returns false when it was dropped.
+    template <typename... Args>
+    bool emplace_at(node_index& node, size_type& slot, Args&&... args) {
+        if (m_size < Capacity) {
+            construct_at(node, slot, std::forward<Args>(args)...);
+            return true;
+        }
+        record_overflow();
+        Overflow::on_overflow();
+        return emplace_evicting(node, slot, detail::overflow_tag<Overflow>(), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    bool emplace_evicting(node_index&, size_type&, std::integral_constant<overflow_action, overflow_action::reject>,
+                          Args&&...) {
+        return false;
+    }
+
+    // The value is built first, the arguments may refer to the element
+    // about to be evicted
+    template <typename Action, typename... Args>
+    bool emplace_evicting(node_index& node, size_type& slot, Action, Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        if (Action::value == overflow_action::overwrite_oldest) {
+            erase_at(m_first, 0);
+        } else {
+            erase_at(m_last, leaf(m_last).m_count - 1);
+        }
+        search(value.first, node, slot);
+        construct_at(node, slot, std::move(value));
+        return true;
+    }
+
+    // Inserts into the leaf, splitting it when full; the upper part goes to
+    // a new leaf after it
+    template <typename... Args>
+    void construct_at(node_index& node, size_type& slot, Args&&... args) {
+        if (node == none) {
+            node = m_root = m_first = m_last = allocate_leaf();
+        }
+        if (leaf(node).m_count < NodeSize) {
+            leaf_node& target = leaf(node);
+            detail::relocate_up(target.values(), slot, target.m_count);
+            new (&target.values()[slot]) value_type(std::forward<Args>(args)...);
+            ++target.m_count;
+            ++m_size;
+            record_insert(m_size, target.m_count - 1 - slot);
+            return;
+        }
+
+        node_index left_index = node;
+        node_index right_index = allocate_leaf();
+        leaf_node& left = leaf(left_index);
+        leaf_node& right = leaf(right_index);
+        // The left leaf ends up with split elements, the right one with the rest
+        const size_type split = (NodeSize + 1) / 2;
+        size_type moved = (slot < split) ? split - 1 : split;
+        detail::btree_relocate(left.values() + moved, NodeSize - moved, right.values());
+        right.m_count = static_cast<typename node_base::count_type>(NodeSize - moved);
+        left.m_count = static_cast<typename node_base::count_type>(moved);
+
+        right.m_prev = left_index;
+        right.m_next = left.m_next;
+        if (left.m_next != none) {
+            leaf(left.m_next).m_prev = right_index;
+        } else {
+            m_last = right_index;
+        }
+        left.m_next = right_index;
+
+        if (slot >= split) {
+            node = right_index;
+            slot -= split;
+        }
+        leaf_node& target = leaf(node);
+        detail::relocate_up(target.values(), slot, target.m_count);
+        new (&target.values()[slot]) value_type(std::forward<Args>(args)...);
+        ++target.m_count;
+        ++m_size;
+        record_insert(m_size, NodeSize - moved + target.m_count - 1 - slot);
+
+        insert_child(left_index, right.values()[0].first, right_index, true);
+    }
+
+    // Adds right, split off left, to their parent with key as separator,
+    // splitting the parent in turn when it overflows; recursion is bounded
+    // by the height of the tree
+    void insert_child(node_index left, const Key& key, node_index right, bool is_leaf) {
+        node_index parent_index = parent_of(left, is_leaf);
+        if (parent_index == none) {
+            node_index root = allocate_inner();
+            inner_node& parent = inner(root);
+            new (&parent.keys()[0]) Key(key);
+            parent.m_children[0] = left;
+            parent.m_children[1] = right;
+            parent.m_count = 2;
+            set_parent(left, is_leaf, root);
+            set_parent(right, is_leaf, root);
+            m_root = root;
+            ++m_height;
+            return;
+        }
+
+        inner_node& parent = inner(parent_index);
+        size_type at = child_slot(parent, left) + 1;
+        detail::relocate_up(parent.keys(), at - 1, key_count(parent));
+        new (&parent.keys()[at - 1]) Key(key);
+        for (size_type i = parent.m_count; i > at; --i) {
+            parent.m_children[i] = parent.m_children[i - 1];
+        }
+        parent.m_children[at] = right;
+        ++parent.m_count;
+        set_parent(right, is_leaf, parent_index);
+        if (parent.m_count <= NodeSize) {
+            return;
+        }
+
+        // NodeSize + 1 children: the left part keeps keep of them, the key
+        // between the parts moves up and the rest go to a new sibling
+        node_index sibling_index = allocate_inner();
+        inner_node& sibling = inner(sibling_index);
+        const size_type keep = (NodeSize + 2) / 2;
+        size_type moved = parent.m_count - keep;
+        detail::btree_relocate(parent.keys() + keep, moved - 1, sibling.keys());
+        for (size_type i = 0; i < moved; ++i) {
+            sibling.m_children[i] = parent.m_children[keep + i];
+            set_parent(sibling.m_children[i], is_leaf, sibling_index);
+        }
+        sibling.m_count = static_cast<typename node_base::count_type>(moved);
+        parent.m_count = static_cast<typename node_base::count_type>(keep);
+        Key up(std::move(parent.keys()[keep - 1]));
+        parent.keys()[keep - 1].~Key();
+        insert_child(parent_index, up, sibling_index, false);
+    }
+
+    // Removes the element and rebalances its leaf; returns the iterator to
+    // the element that followed it
+    iterator erase_at(node_index node, size_type slot) {
+        leaf_node& target = leaf(node);
+        target.values()[slot].~value_type();
+        detail::relocate_down(target.values(), slot, target.m_count);
+        --target.m_count;
+        --m_size;
+        record_erase(target.m_count - slot);
+        if (m_height > 0 && target.m_count < min_fill) {
+            rebalance_leaf(node, slot);
+        }
+        normalize(node, slot);
+        return iterator(this, node, slot);
+    }
+
+    // Refills a leaf below min_fill from a sibling with elements to spare,
+    // or merges it with one. node and slot keep tracking the same position.
+    void rebalance_leaf(node_index& node, size_type& slot) {
+        leaf_node& target = leaf(node);
+        node_index parent_index = target.m_parent;
+        inner_node& parent = inner(parent_index);
+        size_type at = child_slot(parent, node);
+
+        if (at > 0 && leaf(parent.m_children[at - 1]).m_count > min_fill) {
+            leaf_node& left = leaf(parent.m_children[at - 1]);
+            detail::relocate_up(target.values(), 0, target.m_count);
+            detail::btree_relocate(left.values() + (left.m_count - 1), 1, target.values());
+            --left.m_count;
+            ++target.m_count;
+            parent.keys()[at - 1] = target.values()[0].first;
+            ++slot;
+            return;
+        }
+        if (at + 1 < parent.m_count && leaf(parent.m_children[at + 1]).m_count > min_fill) {
+            leaf_node& right = leaf(parent.m_children[at + 1]);
+            detail::btree_relocate(right.values(), 1, target.values() + target.m_count);
+            detail::relocate_down(right.values(), 0, right.m_count);
+            --right.m_count;
+            ++target.m_count;
+            parent.keys()[at] = right.values()[0].first;
+            return;
+        }
+
+        // Neither sibling can spare one: the right leaf of a pair is merged
+        // into the left one
+        if (at > 0) {
+            node_index left_index = parent.m_children[at - 1];
+            slot += leaf(left_index).m_count;
+            merge_leaves(left_index, node);
+            node = left_index;
+            remove_child(parent_index, at, true);
+        } else {
+            merge_leaves(node, parent.m_children[at + 1]);
+            remove_child(parent_index, at + 1, true);
+        }
+    }
+
+    void merge_leaves(node_index left_index, node_index right_index) {
+        leaf_node& left = leaf(left_index);
+        leaf_node& right = leaf(right_index);
+        detail::btree_relocate(right.values(), right.m_count, left.values() + left.m_count);
+        left.m_count = static_cast<typename node_base::count_type>(left.m_count + right.m_count);
+        left.m_next = right.m_next;
+        if (right.m_next != none) {
+            leaf(right.m_next).m_prev = left_index;
+        } else {
+            m_last = left_index;
+        }
+        free_leaf(right_index);
+    }
+
+    // Removes child at (at least 1) and the separator before it; children
+    // are leaves when is_leaf is set
+    void remove_child(node_index parent_index, size_type at, bool is_leaf) {
+        inner_node& parent = inner(parent_index);
+        parent.keys()[at - 1].~Key();
+        detail::relocate_down(parent.keys(), at - 1, key_count(parent));
+        for (size_type i = at; i + 1 < parent.m_count; ++i) {
+            parent.m_children[i] = parent.m_children[i + 1];
+        }
+        --parent.m_count;
+
+        if (parent_index == m_root) {
+            if (parent.m_count == 1) {
+                // The root's only child takes its place
+                m_root = parent.m_children[0];
+                set_parent(m_root, is_leaf, none);
+                free_inner(parent_index);
+                --m_height;
+            }
+        } else if (parent.m_count < min_fill) {
+            rebalance_inner(parent_index, is_leaf);
+        }
+    }
+
+    // As rebalance_leaf, for an inner node; a child moving between siblings
+    // rotates through the separator in the parent
+    void rebalance_inner(node_index node, bool leaf_children) {
+        inner_node& target = inner(node);
+        node_index parent_index = target.m_parent;
+        inner_node& parent = inner(parent_index);
+        size_type at = child_slot(parent, node);
+
+        if (at > 0 && inner(parent.m_children[at - 1]).m_count > min_fill) {
+            inner_node& left = inner(parent.m_children[at - 1]);
+            detail::relocate_up(target.keys(), 0, key_count(target));
+            new (&target.keys()[0]) Key(std::move(parent.keys()[at - 1]));
+            parent.keys()[at - 1] = std::move(left.keys()[left.m_count - 2]);
+            left.keys()[left.m_count - 2].~Key();
+            for (size_type i = target.m_count; i > 0; --i) {
+                target.m_children[i] = target.m_children[i - 1];
+            }
+            target.m_children[0] = left.m_children[left.m_count - 1];
+            set_parent(target.m_children[0], leaf_children, node);
+            --left.m_count;
+            ++target.m_count;
+            return;
+        }
+        if (at + 1 < parent.m_count && inner(parent.m_children[at + 1]).m_count > min_fill) {
+            inner_node& right = inner(parent.m_children[at + 1]);
+            new (&target.keys()[target.m_count - 1]) Key(std::move(parent.keys()[at]));
+            target.m_children[target.m_count] = right.m_children[0];
+            set_parent(target.m_children[target.m_count], leaf_children, node);
+            ++target.m_count;
+            parent.keys()[at] = std::move(right.keys()[0]);
+            right.keys()[0].~Key();
+            detail::relocate_down(right.keys(), 0, key_count(right));
+            for (size_type i = 0; i + 1 < right.m_count; ++i) {
+                right.m_children[i] = right.m_children[i + 1];
+            }
+            --right.m_count;
+            return;
+        }
+
+        if (at > 0) {
+            merge_inners(parent.m_children[at - 1], at - 1, node, leaf_children);
+            remove_child(parent_index, at, false);
+        } else {
+            merge_inners(node, at, parent.m_children[at + 1], leaf_children);
+            remove_child(parent_index, at + 1, false);
+        }
+    }
+
+    // Appends the parent's separator at key and the right node to the left
+    // one; remove_child then drops the moved-from separator
+    void merge_inners(node_index left_index, size_type key, node_index right_index, bool leaf_children) {
+        inner_node& left = inner(left_index);
+        inner_node& right = inner(right_index);
+        inner_node& parent = inner(left.m_parent);
+        new (&left.keys()[left.m_count - 1]) Key(std::move(parent.keys()[key]));
+        detail::btree_relocate(right.keys(), key_count(right), left.keys() + left.m_count);
+        for (size_type i = 0; i < right.m_count; ++i) {
+            left.m_children[left.m_count + i] = right.m_children[i];
+            set_parent(right.m_children[i], leaf_children, left_index);
+        }
+        left.m_count = static_cast<typename node_base::count_type>(left.m_count + right.m_count);
+        free_inner(right_index);
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_unique(V&& value) {
+        node_index node;
+        size_type slot;
+        if (search(value.first, node, slot)) {
+            return std::make_pair(iterator(this, node, slot), false);
+        }
+        if (!emplace_at(node, slot, std::forward<V>(value))) {
+            return std::make_pair(end(), false);
+        }
+        return std::make_pair(iterator(this, node, slot), true);
+    }
+
+    template <typename V>
+    iterator insert_hinted(const_iterator hint, V&& value) {
+        node_index node;
+        size_type slot;
+        if (locate(hint, value.first, node, slot)) {
+            return iterator(this, node, slot);
+        }
+        if (!emplace_at(node, slot, std::forward<V>(value))) {
+            return end();
+        }
+        return iterator(this, node, slot);
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace_key(K&& key, Args&&... args) {
+        node_index node;
+        size_type slot;
+        if (search(key, node, slot)) {
+            return std::make_pair(iterator(this, node, slot), false);
+        }
+        if (!emplace_at(node, slot, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...))) {
+            return std::make_pair(end(), false);
+        }
+        return std::make_pair(iterator(this, node, slot), true);
+    }
+
+    template <typename K, typename... Args>
+    iterator try_emplace_hinted(const_iterator hint, K&& key, Args&&... args) {
+        node_index node;
+        size_type slot;
+        if (locate(hint, key, node, slot)) {
+            return iterator(this, node, slot);
+        }
+        if (!emplace_at(node, slot, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...))) {
+            return end();
+        }
+        return iterator(this, node, slot);
+    }
+
+    template <typename K, typename M>
+    std::pair<iterator, bool> insert_or_assign_key(K&& key, M&& obj) {
+        node_index node;
+        size_type slot;
+        if (search(key, node, slot)) {
+            leaf(node).values()[slot].second = std::forward<M>(obj);
+            return std::make_pair(iterator(this, node, slot), false);
+        }
+        if (!emplace_at(node, slot, std::forward<K>(key), std::forward<M>(obj))) {
+            return std::make_pair(end(), false);
+        }
+        return std::make_pair(iterator(this, node, slot), true);
+    }
+
+    // Copies the other tree's nodes into the same slots, so the indices
+    // linking them carry over; no searches and no splits
+    void copy_nodes(const btree_map& other) {
+        for (size_t i = 1; i <= other.m_untouched_leaves; ++i) {
+            const leaf_node& source = other.leaf(static_cast<node_index>(i));
+            leaf_node& target = leaf(static_cast<node_index>(i));
+            estl::uninitialized_copy(source.values(), source.values() + source.m_count, target.values());
+            target.m_count = source.m_count;
+            target.m_parent = source.m_parent;
+            target.m_prev = source.m_prev;
+            target.m_next = source.m_next;
+        }
+        for (size_t i = 1; i <= other.m_untouched_inners; ++i) {
+            const inner_node& source = other.inner(static_cast<node_index>(i));
+            inner_node& target = inner(static_cast<node_index>(i));
+            estl::uninitialized_copy(source.keys(), source.keys() + key_count(source), target.keys());
+            for (size_t c = 0; c < source.m_count; ++c) {
+                target.m_children[c] = source.m_children[c];
+            }
+            target.m_count = source.m_count;
+            target.m_parent = source.m_parent;
+        }
+        m_root = other.m_root;
+        m_first = other.m_first;
+        m_last = other.m_last;
+        this->m_free_leaf = other.m_free_leaf;
+        this->m_free_inner = other.m_free_inner;
+        this->m_untouched_leaves = other.m_untouched_leaves;
+        this->m_untouched_inners = other.m_untouched_inners;
+        m_height = other.m_height;
+        m_size = other.m_size;
+        record_size(m_size);
+    }
+
+    // Make iterators friends to access private members
+    friend class iterator;
+    friend class const_iterator;
+};
+
+// Non-member functions
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+bool operator==(const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+                const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    return lhs.size() == rhs.size() && estl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+bool operator!=(const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+                const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+bool operator<(const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+               const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    return estl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+bool operator<=(const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+                const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+bool operator>(const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+               const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+bool operator>=(const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+                const btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity, size_t NodeSize, typename Overflow>
+void swap(btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& lhs,
+          btree_map<Key, T, Compare, Capacity, NodeSize, Overflow>& rhs) {
+    lhs.swap(rhs);
+}
+
+} // namespace estl
+
+#endif // ESTL_BTREE_MAP_HPP
@@ -0,0 +1,353 @@
+#ifndef ESTL_CHARCONV_HPP
+#define ESTL_CHARCONV_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "config.hpp"
+#include "bit.hpp"
+
+namespace estl {
+
+/**
+ * @brief Outcome of to_chars
+ *
+ * On success ptr is one past the last character written. When the output
+ * range is too small ok is false, ptr is the end of the range and nothing
+ * has been written.
+ */
+struct to_chars_result {
+    char* ptr;
+    bool ok;
+};
+
+namespace detail {
+
+// "00" to "99", so two decimal digits cost one division
+inline const char* decimal_digit_pairs() {
+    return "00010203040506070809"
+           "10111213141516171819"
+           "20212223242526272829"
+           "30313233343536373839"
+           "40414243444546474849"
+           "50515253545556575859"
+           "60616263646566676869"
+           "70717273747576777879"
+           "80818283848586878889"
+           "90919293949596979899";
+}
+
+template <typename UInt>
+unsigned decimal_length(UInt value) {
+    unsigned length = 1;
+    for (;;) {
+        if (value < 10u) {
+            return length;
+        }
+        if (value < 100u) {
+            return length + 1;
+        }
+        if (value < 1000u) {
+            return length + 2;
+        }
+        if (value < 10000u) {
+            return length + 3;
+        }
+        value /= 10000u;
+        length += 4;
+    }
+}
+
+// Writes the digits of value backwards, ending at last
+template <typename UInt>
+void write_decimal(char* last, UInt value) {
+    const char* pairs = decimal_digit_pairs();
+    while (value >= 100u) {
+        unsigned index = static_cast<unsigned>(value % 100u) * 2;
+        value /= 100u;
+        *--last = pairs[index + 1];
+        *--last = pairs[index];
+    }
+    if (value >= 10u) {
+        unsigned index = static_cast<unsigned>(value) * 2;
+        *--last = pairs[index + 1];
+        *--last = pairs[index];
+    } else {
+        *--last = static_cast<char>('0' + value);
+    }
+}
+
+template <typename UInt>
+to_chars_result decimal_to_chars(char* first, char* last, UInt value) {
+    unsigned length = decimal_length(value);
+    if (last - first < static_cast<ptrdiff_t>(length)) {
+        to_chars_result result = { last, false };
+        return result;
+    }
+    write_decimal(first + length, value);
+    to_chars_result result = { first + length, true };
+    return result;
+}
+
+// Values that fit 32 bits avoid the library calls 64-bit division costs on
+// 32-bit cores
+template <typename UInt>
+to_chars_result unsigned_to_chars(char* first, char* last, UInt value, std::true_type) {
+    if (value <= 0xFFFFFFFFu) {
+        return decimal_to_chars(first, last, static_cast<uint32_t>(value));
+    }
+    return decimal_to_chars(first, last, value);
+}
+
+template <typename UInt>
+to_chars_result unsigned_to_chars(char* first, char* last, UInt value, std::false_type) {
+    return decimal_to_chars(first, last, value);
+}
+
+template <typename UInt>
+to_chars_result unsigned_to_chars(char* first, char* last, UInt value, int base) {
+    if (base == 10) {
+        return unsigned_to_chars(first, last, value, std::integral_constant<bool, (sizeof(UInt) > 4)>());
+    }
+
+    unsigned length = 1;
+    for (UInt rest = value / static_cast<unsigned>(base); rest != 0; rest /= static_cast<unsigned>(base)) {
+        ++length;
+    }
+    if (last - first < static_cast<ptrdiff_t>(length)) {
+        to_chars_result result = { last, false };
+        return result;
+    }
+    const char* digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+    char* out = first + length;
+    do {
+        *--out = digits[value % static_cast<unsigned>(base)];
+        value /= static_cast<unsigned>(base);
+    } while (value != 0);
+    to_chars_result result = { first + length, true };
+    return result;
+}
+
+template <typename Integer>
+bool is_negative(Integer value, std::true_type) {
+    return value < 0;
+}
+
+template <typename Integer>
+bool is_negative(Integer, std::false_type) {
+    return false;
+}
+
+// mantissa * scale / 2^shift for scaled_fraction when the product needs
+// more than 64 bits (at most 113): it is held as two 64-bit halves built
+// from 32-bit multiplies, which every core has. above and tie compare the
+// remainder with half of the divisor.
+inline uint64_t scaled_fraction_wide(uint64_t mantissa, unsigned shift, uint64_t scale, bool& above, bool& tie) {
+    uint64_t a_lo = mantissa & 0xFFFFFFFFu;
+    uint64_t a_hi = mantissa >> 32;
+    uint64_t b_lo = scale & 0xFFFFFFFFu;
+    uint64_t b_hi = scale >> 32;
+    uint64_t cross = (a_lo * b_lo >> 32) + (a_hi * b_lo & 0xFFFFFFFFu) + (a_lo * b_hi & 0xFFFFFFFFu);
+    uint64_t lo = (cross << 32) | (a_lo * b_lo & 0xFFFFFFFFu);
+    uint64_t hi = a_hi * b_hi + (a_hi * b_lo >> 32) + (a_lo * b_hi >> 32) + (cross >> 32);
+
+    uint64_t quotient;
+    uint64_t rest_hi;
+    uint64_t rest_lo;
+    uint64_t half_hi;
+    uint64_t half_lo;
+    if (shift >= 64) {
+        quotient = (shift == 64) ? hi : hi >> (shift - 64);
+        rest_hi = (shift == 64) ? 0 : hi & ((uint64_t(1) << (shift - 64)) - 1);
+        rest_lo = lo;
+        half_hi = (shift == 64) ? 0 : uint64_t(1) << (shift - 65);
+        half_lo = (shift == 64) ? uint64_t(1) << 63 : 0;
+    } else {
+        quotient = (hi << (64 - shift)) | (lo >> shift);
+        rest_hi = 0;
+        rest_lo = lo & ((uint64_t(1) << shift) - 1);
+        half_hi = 0;
+        half_lo = uint64_t(1) << (shift - 1);
+    }
+    above = rest_hi > half_hi || (rest_hi == half_hi && rest_lo > half_lo);
+    tie = rest_hi == half_hi && rest_lo == half_lo;
+    return quotient;
+}
+
+// fraction * scale rounded to the nearest integer, computed exactly from
+// the bits of fraction (0 <= fraction < 1, scale <= 10^18) as printf does.
+// Ties go to the even last digit, which with no fraction digits (scale 1)
+// is that of integral.
+inline uint64_t scaled_fraction(double fraction, uint64_t scale, uint64_t integral) {
+    uint64_t bits;
+    std::memcpy(&bits, &fraction, sizeof(bits));
+    unsigned biased = static_cast<unsigned>(bits >> 52) & 0x7FFu;
+    uint64_t mantissa = bits & ((uint64_t(1) << 52) - 1);
+    if (biased == 0 && mantissa == 0) {
+        return 0;
+    }
+    // fraction = mantissa / 2^shift
+    unsigned shift = 1074;
+    if (biased != 0) {
+        mantissa |= uint64_t(1) << 52;
+        shift = 1075 - biased;
+    }
+    unsigned zeros = static_cast<unsigned>(estl::countr_zero(mantissa));
+    mantissa >>= zeros;
+    shift -= zeros;
+    // Below 2^113 the product is less than half of 2^shift
+    if (shift > 114) {
+        return 0;
+    }
+
+    // Divides by 2^shift, comparing the remainder with half of it
+    uint64_t quotient;
+    bool above;
+    bool tie;
+    if (shift < 64 && estl::bit_width(mantissa) + estl::bit_width(scale) <= 64) {
+        // The common case of a few fraction digits: 64 bits suffice
+        uint64_t product = mantissa * scale;
+        uint64_t rest = product & ((uint64_t(1) << shift) - 1);
+        uint64_t half = uint64_t(1) << (shift - 1);
+        quotient = product >> shift;
+        above = rest > half;
+        tie = rest == half;
+    } else {
+        quotient = scaled_fraction_wide(mantissa, shift, scale, above, tie);
+    }
+    uint64_t last_digit = (scale == 1) ? integral : quotient;
+    return quotient + ((above || (tie && (last_digit & 1u) != 0)) ? 1u : 0u);
+}
+
+inline to_chars_result copy_chars(char* first, char* last, const char* text, size_t length) {
+    if (static_cast<size_t>(last - first) < length) {
+        to_chars_result result = { last, false };
+        return result;
+    }
+    std::memcpy(first, text, length);
+    to_chars_result result = { first + length, true };
+    return result;
+}
+
+} // namespace detail
+
+/**
+ * @brief Writes value in the given base (2 to 36) into [first, last)
+ *
+ * A replacement for snprintf("%d") that allocates nothing, needs no format
+ * parsing and writes no terminator. Decimal output emits two digits per
+ * division.
+ */
+template <typename Integer, typename = typename std::enable_if<
+              std::is_integral<Integer>::value && !std::is_same<Integer, bool>::value>::type>
+to_chars_result to_chars(char* first, char* last, Integer value, int base = 10) {
+    ESTL_ASSERT(base >= 2 && base <= 36);
+    using unsigned_type = typename std::make_unsigned<Integer>::type;
+    unsigned_type magnitude = static_cast<unsigned_type>(value);
+    if (detail::is_negative(value, std::is_signed<Integer>())) {
+        if (first == last) {
+            to_chars_result result = { last, false };
+            return result;
+        }
+        to_chars_result result = detail::unsigned_to_chars(first + 1, last, unsigned_type(0 - magnitude), base);
+        if (result.ok) {
+            *first = '-';
+        }
+        return result;
+    }
+    return detail::unsigned_to_chars(first, last, magnitude, base);
+}
+
+/**
+ * @brief Writes value with precision digits after the point, like "%.*f"
+ *
+ * Below 1e18 the output is that of "%.*f": the exact binary value is
+ * rounded to nearest with ties to even (0.5 gives "0", 2.5 gives "2") and
+ * -0.0 keeps its sign. Values of 1e18 and above are written in exponent
+ * form ("1.500000e+20") with a mantissa scaled by double arithmetic, exact
+ * to about 15 significant digits and rounded half away from zero.
+ * precision is capped at 18.
+ */
+inline to_chars_result to_chars(char* first, char* last, double value, int precision = 6) {
+    if (precision < 0) {
+        precision = 0;
+    } else if (precision > 18) {
+        precision = 18;
+    }
+    if (value != value) {
+        return detail::copy_chars(first, last, "nan", 3);
+    }
+
+    // Sign, up to 19 integer digits, point, 18 fraction digits and exponent
+    char buffer[48];
+    char* out = buffer;
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if ((bits >> 63) != 0) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (value > 1.7976931348623157e308) {
+        std::memcpy(out, "inf", 3);
+        return detail::copy_chars(first, last, buffer, static_cast<size_t>(out + 3 - buffer));
+    }
+
+    int exponent = 0;
+    bool scientific = value >= 1e18;
+    if (scientific) {
+        while (value >= 10.0) {
+            value /= 10.0;
+            ++exponent;
+        }
+    }
+
+    uint64_t scale = 1;
+    for (int i = 0; i < precision; ++i) {
+        scale *= 10u;
+    }
+    uint64_t integral = static_cast<uint64_t>(value);
+    // Exact: below 1e18 a double has no bits below its integer part's grain
+    double rest = value - static_cast<double>(integral);
+    uint64_t fraction = scientific ? static_cast<uint64_t>(rest * static_cast<double>(scale) + 0.5)
+                                   : detail::scaled_fraction(rest, scale, integral);
+    if (fraction >= scale) {
+        fraction -= scale;
+        ++integral;
+    }
+    if (scientific && integral >= 10u) {
+        // The mantissa rounded up to 10
+        integral = 1;
+        ++exponent;
+    }
+
+    out = detail::decimal_to_chars(out, buffer + sizeof(buffer), integral).ptr;
+    if (precision > 0) {
+        *out++ = '.';
+        out += precision;
+        char* digit = out;
+        for (int i = 0; i < precision; ++i) {
+            *--digit = static_cast<char>('0' + fraction % 10u);
+            fraction /= 10u;
+        }
+    }
+    if (scientific) {
+        *out++ = 'e';
+        *out++ = '+';
+        if (exponent < 100) {
+            *out++ = static_cast<char>('0' + exponent / 10);
+            *out++ = static_cast<char>('0' + exponent % 10);
+        } else {
+            out = detail::decimal_to_chars(out, buffer + sizeof(buffer), static_cast<unsigned>(exponent)).ptr;
+        }
+    }
+    return detail::copy_chars(first, last, buffer, static_cast<size_t>(out - buffer));
+}
+
+inline to_chars_result to_chars(char* first, char* last, float value, int precision = 6) {
+    return to_chars(first, last, static_cast<double>(value), precision);
+}
+
+} // namespace estl
+
+#endif // ESTL_CHARCONV_HPP
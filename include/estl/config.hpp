@@ -25,12 +25,142 @@
     #define ESTL_PLATFORM_AVR
 #endif
 
+// Atomic operations
+// Containers shared between interrupts and tasks use <atomic> where the
+// toolchain provides it. Without it (e.g. avr-gcc) they fall back to volatile
+// accesses ordered by ESTL_COMPILER_BARRIER, which is sufficient on
+// single-core parts where only the compiler can reorder memory accesses.
+#ifndef ESTL_HAS_ATOMIC
+    #if defined(ESTL_PLATFORM_AVR)
+        #define ESTL_HAS_ATOMIC 0
+    #else
+        #define ESTL_HAS_ATOMIC 1
+    #endif
+#endif
+
+#ifndef ESTL_COMPILER_BARRIER
+    #define ESTL_COMPILER_BARRIER() __asm__ __volatile__("" ::: "memory")
+#endif
+
+// Memory ordering of the lock-free containers (spsc_ring, mpmc_queue and the
+// executor deques). By default each access uses the weakest ordering it
+// needs; set to 1 to make every access sequentially consistent, e.g. to rule
+// out an ordering problem when bringing up a new core.
+#ifndef ESTL_ATOMIC_SEQ_CST
+    #define ESTL_ATOMIC_SEQ_CST 0
+#endif
+
+// Cache line size used to keep producer and consumer state apart
+#ifndef ESTL_CACHE_LINE_SIZE
+    #if defined(ESTL_PLATFORM_AVR)
+        #define ESTL_CACHE_LINE_SIZE 1
+    #elif defined(ESTL_PLATFORM_ARM)
+        #define ESTL_CACHE_LINE_SIZE 32
+    #else
+        #define ESTL_CACHE_LINE_SIZE 64
+    #endif
+#endif
+
+// Spin-wait hint issued by executor workers while they look for work
+#ifndef ESTL_CPU_RELAX
+    #if (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__)
+        #define ESTL_CPU_RELAX() __builtin_ia32_pause()
+    #elif defined(ESTL_PLATFORM_ARM)
+        #define ESTL_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+    #else
+        #define ESTL_CPU_RELAX() ESTL_COMPILER_BARRIER()
+    #endif
+#endif
+
+// std::thread is available, enabling estl::thread_executor on host builds
+#ifndef ESTL_HAS_THREADS
+    #if ESTL_HAS_ATOMIC && (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+        #define ESTL_HAS_THREADS 1
+    #else
+        #define ESTL_HAS_THREADS 0
+    #endif
+#endif
+
+// Parallel algorithms never split a range into pieces smaller than this,
+// so the cost of handing a piece to another core stays well below the work
+#ifndef ESTL_PARALLEL_MIN_CHUNK
+    #define ESTL_PARALLEL_MIN_CHUNK 512
+#endif
+
+// Vectorized kernels for find, count and fill on integer ranges
+// x86 hosts use SSE2 or AVX2, ARM targets a portable word-at-a-time (SWAR)
+// kernel; everything else keeps the element loops. Define ESTL_SIMD to one
+// of the values below to override the detection.
+#define ESTL_SIMD_NONE 0
+#define ESTL_SIMD_SWAR 1
+#define ESTL_SIMD_SSE2 2
+#define ESTL_SIMD_AVX2 3
+
+#ifndef ESTL_SIMD
+    #if defined(__AVX2__) && defined(__GNUC__)
+        #define ESTL_SIMD ESTL_SIMD_AVX2
+    #elif defined(__SSE2__) && defined(__GNUC__)
+        #define ESTL_SIMD ESTL_SIMD_SSE2
+    #elif defined(ESTL_PLATFORM_ARM)
+        #define ESTL_SIMD ESTL_SIMD_SWAR
+    #else
+        #define ESTL_SIMD ESTL_SIMD_NONE
+    #endif
+#endif
+
 // Memory management configuration
 // By default, no dynamic memory allocation is used
 #ifndef ESTL_USE_DYNAMIC_MEMORY
     #define ESTL_USE_DYNAMIC_MEMORY 0
 #endif
 
+// Called with the container's storage address and the block size in bytes
+// whenever a small_vector outgrows its inline elements. Define it to log
+// which instances spill when sizing InlineN from field data.
+#ifndef ESTL_SPILL_HOOK
+    #define ESTL_SPILL_HOOK(storage, bytes) ((void)0)
+#endif
+
+// Container instrumentation
+// When set, vector and map count inserts, erases, finds, shifted elements
+// and refused insertions and track their high-water size; the counters are
+// listed by estl::visit_statistics(). Off by default, and compiled out
+// entirely when off.
+#ifndef ESTL_ENABLE_STATS
+    #define ESTL_ENABLE_STATS 0
+#endif
+
+// Sorting configuration
+// Ranges at or below this size are finished with insertion sort
+#ifndef ESTL_SORT_INSERTION_THRESHOLD
+    #define ESTL_SORT_INSERTION_THRESHOLD 16
+#endif
+
+// Number of pending partitions estl::sort keeps on its explicit stack.
+// The larger partition is always deferred, so log2(N) entries are enough
+// for any N; if the stack is full the deferred range is heapsorted instead.
+#ifndef ESTL_SORT_STACK_DEPTH
+    #define ESTL_SORT_STACK_DEPTH 32
+#endif
+
+// When non-zero, estl::sort with less or greater on byte-sized integers
+// counts them instead (estl::counting_sort) from this many elements on.
+// Off by default: the histogram takes 256 size_t of stack (1 KB on a
+// 32-bit target) on top of sort's own fixed partition stack.
+#ifndef ESTL_SORT_COUNTING_THRESHOLD
+    #define ESTL_SORT_COUNTING_THRESHOLD 0
+#endif
+
+// Relaxed constexpr (loops and local variables in constexpr functions),
+// available from C++14; selects the cheaper compile-time paths
+#ifndef ESTL_HAS_CONSTEXPR14
+    #if __cplusplus >= 201402L
+        #define ESTL_HAS_CONSTEXPR14 1
+    #else
+        #define ESTL_HAS_CONSTEXPR14 0
+    #endif
+#endif
+
 // Version information
 #define ESTL_VERSION_MAJOR 0
 #define ESTL_VERSION_MINOR 1
@@ -0,0 +1,665 @@
+#ifndef ESTL_EXECUTION_HPP
+#define ESTL_EXECUTION_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "atomic.hpp"
+#include "utility.hpp"
+
+#if ESTL_HAS_THREADS
+    #include <thread>
+#endif
+
+namespace estl {
+
+class executor;
+
+/**
+ * Execution policies
+ *
+ * sort, for_each, transform and count_if take estl::seq or estl::par as a
+ * first argument. par splits random-access ranges across the workers of an
+ * executor: the one given with par.on(exec), otherwise the default set by
+ * set_default_executor(). Without an executor, without ESTL_HAS_ATOMIC or
+ * for other iterator categories the algorithm runs sequentially, so code
+ * written for a dual-core part still builds and runs on a single-core one.
+ *
+ * The calling context acts as worker 0 of the executor while the algorithm
+ * runs; the element functions must be safe to call from several cores at
+ * once. Only one parallel algorithm runs on an executor at a time: a par
+ * call made while another is running, e.g. from an element function on any
+ * worker, runs sequentially in its caller. Tasks submitted to other workers
+ * must not call par algorithms on the same executor.
+ */
+struct sequenced_policy {};
+
+struct parallel_policy {
+    constexpr parallel_policy() : m_executor(nullptr) {}
+    constexpr explicit parallel_policy(executor* exec) : m_executor(exec) {}
+
+    // Runs on exec instead of the default executor
+    constexpr parallel_policy on(executor& exec) const {
+        return parallel_policy(&exec);
+    }
+
+    constexpr executor* target() const {
+        return m_executor;
+    }
+
+private:
+    executor* m_executor;
+};
+
+constexpr sequenced_policy seq = sequenced_policy();
+constexpr parallel_policy par = parallel_policy();
+
+namespace detail {
+
+template <typename = void>
+struct default_executor_slot {
+    static executor* instance;
+};
+
+template <typename Unused>
+executor* default_executor_slot<Unused>::instance = nullptr;
+
+} // namespace detail
+
+// Executor used by estl::par; set it once at startup, before the workers run
+inline void set_default_executor(executor* exec) {
+    detail::default_executor_slot<>::instance = exec;
+}
+
+inline executor* default_executor() {
+    return detail::default_executor_slot<>::instance;
+}
+
+#if ESTL_HAS_ATOMIC
+
+/**
+ * @brief A unit of work queued on an executor
+ *
+ * Derive from it and pass the static function that runs the derived object;
+ * the task must stay alive until it has run. Tasks are never copied or
+ * allocated by the executor.
+ */
+class executor_task {
+public:
+    using run_function = void (*)(executor_task& task, executor& exec, size_t worker);
+
+    constexpr explicit executor_task(run_function function) : m_run(function) {}
+
+    executor_task(const executor_task&) = delete;
+    executor_task& operator=(const executor_task&) = delete;
+
+    void run(executor& exec, size_t worker) {
+        m_run(*this, exec, worker);
+    }
+
+private:
+    run_function m_run;
+};
+
+namespace detail {
+
+/**
+ * Chase-Lev work-stealing deque of task pointers, with the memory orderings
+ * of Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+ * Models". The owning worker pushes and pops at the bottom, any other worker
+ * steals from the top. The slot array has a fixed power-of-two size; push
+ * fails rather than grow it.
+ */
+class work_deque {
+public:
+    static constexpr size_t line_align = (ESTL_CACHE_LINE_SIZE > alignof(atomic_value<ptrdiff_t>))
+        ? ESTL_CACHE_LINE_SIZE : alignof(atomic_value<ptrdiff_t>);
+
+    constexpr work_deque(atomic_value<executor_task*>* slots, size_t capacity)
+        : m_slots(slots), m_mask(static_cast<ptrdiff_t>(capacity) - 1), m_top(0), m_bottom(0) {}
+
+    work_deque(const work_deque&) = delete;
+    work_deque& operator=(const work_deque&) = delete;
+
+    // Owner only
+    bool push(executor_task* task) {
+        ptrdiff_t bottom = m_bottom.load_relaxed();
+        if (bottom - m_top.load_acquire() > m_mask) {
+            return false;
+        }
+        m_slots[bottom & m_mask].store_relaxed(task);
+        m_bottom.store_release(bottom + 1);
+        return true;
+    }
+
+    // Owner only; the most recently pushed task, or nullptr
+    executor_task* pop() {
+        ptrdiff_t bottom = m_bottom.load_relaxed() - 1;
+        m_bottom.store_relaxed(bottom);
+        atomic_fence();
+        ptrdiff_t top = m_top.load_relaxed();
+        if (top > bottom) {
+            m_bottom.store_relaxed(bottom + 1);
+            return nullptr;
+        }
+        executor_task* task = m_slots[bottom & m_mask].load_relaxed();
+        if (top == bottom) {
+            // The last task: thieves may be racing for it
+            if (!m_top.compare_exchange(top, top + 1)) {
+                task = nullptr;
+            }
+            m_bottom.store_relaxed(bottom + 1);
+        }
+        return task;
+    }
+
+    // Any other worker; the oldest task, or nullptr if empty or lost to a race
+    executor_task* steal() {
+        ptrdiff_t top = m_top.load_acquire();
+        atomic_fence();
+        ptrdiff_t bottom = m_bottom.load_acquire();
+        if (top >= bottom) {
+            return nullptr;
+        }
+        executor_task* task = m_slots[top & m_mask].load_relaxed();
+        if (!m_top.compare_exchange(top, top + 1)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+private:
+    atomic_value<executor_task*>* m_slots;
+    ptrdiff_t m_mask;
+    // Advanced by thieves
+    alignas(line_align) atomic_value<ptrdiff_t> m_top;
+    // Written by the owner only
+    alignas(line_align) atomic_value<ptrdiff_t> m_bottom;
+};
+
+constexpr size_t work_deque::line_align;
+
+// The second half of a fork_join, queued for another worker to steal
+template <typename Function>
+class forked_task : public executor_task {
+public:
+    explicit forked_task(Function& function) : executor_task(&forked_task::execute), m_function(function), m_done() {}
+
+    bool done() const {
+        return m_done.load_acquire() != 0;
+    }
+
+private:
+    static void execute(executor_task& task, executor& exec, size_t worker) {
+        forked_task& self = static_cast<forked_task&>(task);
+        self.m_function(exec, worker);
+        // The forking worker may return and destroy the task from here on
+        self.m_done.store_release(1);
+    }
+
+    Function& m_function;
+    atomic_value<unsigned char> m_done;
+};
+
+class parallel_region;
+
+} // namespace detail
+
+/**
+ * @brief A work-stealing executor over a fixed set of workers
+ *
+ * Each worker owns a deque of tasks; an idle worker pops its own newest
+ * task, then steals the oldest task of the others in turn. Worker 0 is the
+ * context that issues work (e.g. the main loop on core 0); every other
+ * worker runs run_worker() on its own core or thread until stop().
+ *
+ * Nothing is allocated: use static_executor, which holds the deques, or
+ * thread_executor on hosts. A task is queued only by the worker that owns
+ * the deque, so the parallel algorithms, which queue on worker 0's deque,
+ * run one at a time; see detail::parallel_region.
+ */
+class executor {
+public:
+    executor(const executor&) = delete;
+    executor& operator=(const executor&) = delete;
+
+    size_t workers() const {
+        return m_workers;
+    }
+
+    // Queues task on worker's deque; false if the deque is full
+    bool submit(size_t worker, executor_task& task) {
+        ESTL_ASSERT(worker < m_workers);
+        return m_deques[worker].push(&task);
+    }
+
+    // Runs one task, the worker's own or a stolen one; false if none was found
+    bool run_one(size_t worker) {
+        executor_task* task = find_task(worker);
+        if (task == nullptr) {
+            return false;
+        }
+        task->run(*this, worker);
+        return true;
+    }
+
+    /**
+     * @brief Runs tasks until stop() is called
+     *
+     * The loop of each worker other than worker 0; idle() is called whenever
+     * no task is found, e.g. to yield to an RTOS or wait for an event.
+     */
+    template <typename Idle>
+    void run_worker(size_t worker, Idle idle) {
+        while (m_stop.load_acquire() == 0) {
+            if (!run_one(worker)) {
+                idle();
+            }
+        }
+    }
+
+    void run_worker(size_t worker) {
+        run_worker(worker, [] { ESTL_CPU_RELAX(); });
+    }
+
+    void stop() {
+        m_stop.store_release(1);
+    }
+
+    /**
+     * @brief Runs left and right, possibly in parallel, and waits for both
+     *
+     * right is offered for stealing while the calling worker runs left; the
+     * worker then runs other tasks until right has finished. Both are called
+     * as f(executor&, worker) with the worker actually running them. When
+     * the deque is full, both run in the calling worker.
+     */
+    template <typename Left, typename Right>
+    void fork_join(size_t worker, Left& left, Right& right) {
+        detail::forked_task<Right> forked(right);
+        if (!m_deques[worker].push(&forked)) {
+            left(*this, worker);
+            right(*this, worker);
+            return;
+        }
+        left(*this, worker);
+        while (!forked.done()) {
+            if (!run_one(worker)) {
+                ESTL_CPU_RELAX();
+            }
+        }
+    }
+
+protected:
+    constexpr executor(detail::work_deque* deques, size_t workers)
+        : m_deques(deques), m_workers(workers), m_stop(), m_busy() {}
+
+private:
+    friend class detail::parallel_region;
+
+    executor_task* find_task(size_t worker) {
+        executor_task* task = m_deques[worker].pop();
+        for (size_t i = 1; task == nullptr && i < m_workers; ++i) {
+            size_t victim = worker + i;
+            task = m_deques[(victim < m_workers) ? victim : victim - m_workers].steal();
+        }
+        return task;
+    }
+
+    detail::work_deque* m_deques;
+    size_t m_workers;
+    detail::atomic_value<unsigned char> m_stop;
+    // Set while a parallel algorithm owns worker 0's deque
+    detail::atomic_value<unsigned char> m_busy;
+};
+
+/**
+ * @brief An executor whose deques live inside the object
+ *
+ * Constant-initialized, so it can be a global shared by the cores. Depth
+ * bounds the tasks queued per worker; the parallel algorithms queue at most
+ * one per level of splitting, i.e. about log2(N / ESTL_PARALLEL_MIN_CHUNK).
+ *
+ * @tparam Workers The number of workers, including worker 0
+ * @tparam Depth Tasks per worker deque, a power of two
+ */
+template <size_t Workers, size_t Depth = 32>
+class static_executor : public executor {
+    static_assert(Workers > 0, "static_executor needs at least one worker");
+    static_assert(Depth >= 2 && (Depth & (Depth - 1)) == 0, "static_executor Depth must be a power of two");
+
+public:
+    constexpr static_executor() : static_executor(detail::make_index_sequence<Workers>()) {}
+
+private:
+    template <size_t... I>
+    constexpr explicit static_executor(detail::index_sequence<I...>)
+        : executor(m_deques, Workers), m_slots(), m_deques{ { m_slots[I], Depth }... } {}
+
+    detail::atomic_value<executor_task*> m_slots[Workers][Depth];
+    detail::work_deque m_deques[Workers];
+};
+
+#if ESTL_HAS_THREADS
+
+/**
+ * @brief A static_executor whose workers 1 to Workers-1 are std::threads
+ *
+ * For host builds and simulators. The threads start in the constructor and
+ * are stopped and joined by the destructor; the thread that calls the
+ * parallel algorithms is worker 0.
+ */
+template <size_t Workers, size_t Depth = 32>
+class thread_executor : public static_executor<Workers, Depth> {
+    static_assert(Workers > 1, "thread_executor needs at least two workers");
+
+public:
+    thread_executor() {
+        for (size_t i = 1; i < Workers; ++i) {
+            m_threads[i - 1] = std::thread(&thread_executor::host_worker, this, i);
+        }
+    }
+
+    ~thread_executor() {
+        this->stop();
+        for (size_t i = 0; i < Workers - 1; ++i) {
+            m_threads[i].join();
+        }
+    }
+
+private:
+    void host_worker(size_t worker) {
+        this->run_worker(worker, [] { std::this_thread::yield(); });
+    }
+
+    std::thread m_threads[Workers - 1];
+};
+
+#endif
+
+namespace detail {
+
+/**
+ * The executor a parallel algorithm runs on, if any
+ *
+ * Claims the executor for the lifetime of the region, so that only the
+ * outermost par call pushes to worker 0's deque. Empty, and the algorithm
+ * sequential, without an executor of two or more workers, for a range too
+ * short to split, or for a nested call: that one may be running on any
+ * worker, and only worker 0 may push to its deque.
+ */
+class parallel_region {
+public:
+    parallel_region(const parallel_policy& policy, size_t count) : m_executor(nullptr) {
+        executor* exec = policy.target() ? policy.target() : default_executor();
+        if (exec == nullptr || exec->workers() < 2 || count <= ESTL_PARALLEL_MIN_CHUNK) {
+            return;
+        }
+        unsigned char idle = 0;
+        if (exec->m_busy.compare_exchange(idle, 1)) {
+            m_executor = exec;
+        }
+    }
+
+    ~parallel_region() {
+        if (m_executor != nullptr) {
+            m_executor->m_busy.store_release(0);
+        }
+    }
+
+    parallel_region(const parallel_region&) = delete;
+    parallel_region& operator=(const parallel_region&) = delete;
+
+    executor* target() const {
+        return m_executor;
+    }
+
+private:
+    executor* m_executor;
+};
+
+// About four pieces per worker, so stolen pieces even out the load
+inline size_t parallel_grain(size_t count, size_t workers) {
+    size_t grain = count / (workers * 4);
+    return (grain < ESTL_PARALLEL_MIN_CHUNK) ? ESTL_PARALLEL_MIN_CHUNK : grain;
+}
+
+// Calls body(first, last) for pieces of at most grain elements
+template <typename RandomIt, typename Body>
+void parallel_chunks(executor& exec, size_t worker, RandomIt first, RandomIt last, size_t grain, Body& body) {
+    if (static_cast<size_t>(last - first) <= grain) {
+        body(first, last);
+        return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+    auto left = [&](executor& e, size_t w) { parallel_chunks(e, w, first, mid, grain, body); };
+    auto right = [&](executor& e, size_t w) { parallel_chunks(e, w, mid, last, grain, body); };
+    exec.fork_join(worker, left, right);
+}
+
+template <typename RandomIt, typename UnaryPredicate>
+typename iterator_traits<RandomIt>::difference_type
+parallel_count_if(executor& exec, size_t worker, RandomIt first, RandomIt last, size_t grain, UnaryPredicate& p) {
+    if (static_cast<size_t>(last - first) <= grain) {
+        return estl::count_if(first, last, p);
+    }
+    RandomIt mid = first + (last - first) / 2;
+    typename iterator_traits<RandomIt>::difference_type lower = 0;
+    typename iterator_traits<RandomIt>::difference_type upper = 0;
+    auto left = [&](executor& e, size_t w) { lower = parallel_count_if(e, w, first, mid, grain, p); };
+    auto right = [&](executor& e, size_t w) { upper = parallel_count_if(e, w, mid, last, grain, p); };
+    exec.fork_join(worker, left, right);
+    return lower + upper;
+}
+
+// Partitions as estl::sort does, handing the upper side of each split to
+// the executor; depth bounds the splits before the pieces are sorted whole
+template <typename RandomIt, typename Compare>
+void parallel_sort(executor& exec, size_t worker, RandomIt first, RandomIt last, size_t grain, int depth,
+                   Compare& comp) {
+    if (static_cast<size_t>(last - first) <= grain || depth == 0) {
+        estl::sort(first, last, comp);
+        return;
+    }
+    RandomIt mid = first + (last - first) / 2;
+    detail::move_median_to_first(first, first + 1, mid, last - 1, comp);
+    RandomIt cut = detail::unguarded_partition(first + 1, last, first, comp);
+    auto left = [&](executor& e, size_t w) { parallel_sort(e, w, first, cut, grain, depth - 1, comp); };
+    auto right = [&](executor& e, size_t w) { parallel_sort(e, w, cut, last, grain, depth - 1, comp); };
+    exec.fork_join(worker, left, right);
+}
+
+template <typename RandomIt, typename OutputIt, typename UnaryOperation>
+struct transform_body {
+    void operator()(RandomIt piece_first, RandomIt piece_last) {
+        estl::transform(piece_first, piece_last, d_first + (piece_first - first), op);
+    }
+
+    RandomIt first;
+    OutputIt d_first;
+    UnaryOperation& op;
+};
+
+template <typename Iterator>
+using is_random_access = std::is_convertible<typename iterator_traits<Iterator>::iterator_category,
+                                             random_access_iterator_tag>;
+
+} // namespace detail
+
+#endif // ESTL_HAS_ATOMIC
+
+// Sequenced overloads, for code that selects the policy generically
+template <typename RandomIt>
+void sort(const sequenced_policy&, RandomIt first, RandomIt last) {
+    estl::sort(first, last);
+}
+
+template <typename RandomIt, typename Compare>
+void sort(const sequenced_policy&, RandomIt first, RandomIt last, Compare comp) {
+    estl::sort(first, last, comp);
+}
+
+template <typename InputIt, typename UnaryFunction>
+void for_each(const sequenced_policy&, InputIt first, InputIt last, UnaryFunction f) {
+    estl::for_each(first, last, f);
+}
+
+template <typename InputIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(const sequenced_policy&, InputIt first, InputIt last, OutputIt d_first, UnaryOperation op) {
+    return estl::transform(first, last, d_first, op);
+}
+
+template <typename InputIt, typename UnaryPredicate>
+typename iterator_traits<InputIt>::difference_type
+count_if(const sequenced_policy&, InputIt first, InputIt last, UnaryPredicate p) {
+    return estl::count_if(first, last, p);
+}
+
+// Parallel overloads
+#if ESTL_HAS_ATOMIC
+
+/**
+ * @brief Sorts [first, last) on the workers of the policy's executor
+ *
+ * The top 2*log2(workers) + 1 partitions are split as in estl::sort, with
+ * the pieces handed to other workers; each piece is then finished by
+ * estl::sort. The first partition is sequential, so the speedup grows more
+ * slowly than the worker count.
+ */
+template <typename RandomIt, typename Compare>
+void sort(const parallel_policy& policy, RandomIt first, RandomIt last, Compare comp) {
+    size_t count = static_cast<size_t>(last - first);
+    detail::parallel_region region(policy, count);
+    executor* exec = region.target();
+    if (exec == nullptr) {
+        estl::sort(first, last, comp);
+        return;
+    }
+    int depth = 1;
+    for (size_t n = exec->workers(); n > 1; n >>= 1) {
+        depth += 2;
+    }
+    detail::parallel_sort(*exec, 0, first, last, detail::parallel_grain(count, exec->workers()), depth, comp);
+}
+
+template <typename RandomIt>
+void sort(const parallel_policy& policy, RandomIt first, RandomIt last) {
+    estl::sort(policy, first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+namespace detail {
+
+template <typename RandomIt, typename UnaryFunction>
+void for_each(const parallel_policy& policy, RandomIt first, RandomIt last, UnaryFunction& f, std::true_type) {
+    size_t count = static_cast<size_t>(last - first);
+    detail::parallel_region region(policy, count);
+    executor* exec = region.target();
+    if (exec == nullptr) {
+        estl::for_each(first, last, f);
+        return;
+    }
+    auto body = [&f](RandomIt piece_first, RandomIt piece_last) { estl::for_each(piece_first, piece_last, f); };
+    parallel_chunks(*exec, 0, first, last, parallel_grain(count, exec->workers()), body);
+}
+
+template <typename InputIt, typename UnaryFunction>
+void for_each(const parallel_policy&, InputIt first, InputIt last, UnaryFunction& f, std::false_type) {
+    estl::for_each(first, last, f);
+}
+
+template <typename RandomIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(const parallel_policy& policy, RandomIt first, RandomIt last, OutputIt d_first,
+                   UnaryOperation& op, std::true_type) {
+    size_t count = static_cast<size_t>(last - first);
+    detail::parallel_region region(policy, count);
+    executor* exec = region.target();
+    if (exec == nullptr) {
+        return estl::transform(first, last, d_first, op);
+    }
+    transform_body<RandomIt, OutputIt, UnaryOperation> body = { first, d_first, op };
+    parallel_chunks(*exec, 0, first, last, parallel_grain(count, exec->workers()), body);
+    return d_first + (last - first);
+}
+
+template <typename InputIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(const parallel_policy&, InputIt first, InputIt last, OutputIt d_first,
+                   UnaryOperation& op, std::false_type) {
+    return estl::transform(first, last, d_first, op);
+}
+
+template <typename RandomIt, typename UnaryPredicate>
+typename iterator_traits<RandomIt>::difference_type
+count_if(const parallel_policy& policy, RandomIt first, RandomIt last, UnaryPredicate& p, std::true_type) {
+    size_t count = static_cast<size_t>(last - first);
+    detail::parallel_region region(policy, count);
+    executor* exec = region.target();
+    if (exec == nullptr) {
+        return estl::count_if(first, last, p);
+    }
+    return parallel_count_if(*exec, 0, first, last, parallel_grain(count, exec->workers()), p);
+}
+
+template <typename InputIt, typename UnaryPredicate>
+typename iterator_traits<InputIt>::difference_type
+count_if(const parallel_policy&, InputIt first, InputIt last, UnaryPredicate& p, std::false_type) {
+    return estl::count_if(first, last, p);
+}
+
+} // namespace detail
+
+// f is shared by the workers, not copied per piece
+template <typename InputIt, typename UnaryFunction>
+void for_each(const parallel_policy& policy, InputIt first, InputIt last, UnaryFunction f) {
+    detail::for_each(policy, first, last, f, detail::is_random_access<InputIt>());
+}
+
+// Parallel only when the output iterator is random access too
+template <typename InputIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(const parallel_policy& policy, InputIt first, InputIt last, OutputIt d_first, UnaryOperation op) {
+    return detail::transform(policy, first, last, d_first, op,
+                             std::integral_constant<bool, detail::is_random_access<InputIt>::value &&
+                                                              detail::is_random_access<OutputIt>::value>());
+}
+
+template <typename InputIt, typename UnaryPredicate>
+typename iterator_traits<InputIt>::difference_type
+count_if(const parallel_policy& policy, InputIt first, InputIt last, UnaryPredicate p) {
+    return detail::count_if(policy, first, last, p, detail::is_random_access<InputIt>());
+}
+
+#else
+
+// No atomics: estl::par runs sequentially
+template <typename RandomIt>
+void sort(const parallel_policy&, RandomIt first, RandomIt last) {
+    estl::sort(first, last);
+}
+
+template <typename RandomIt, typename Compare>
+void sort(const parallel_policy&, RandomIt first, RandomIt last, Compare comp) {
+    estl::sort(first, last, comp);
+}
+
+template <typename InputIt, typename UnaryFunction>
+void for_each(const parallel_policy&, InputIt first, InputIt last, UnaryFunction f) {
+    estl::for_each(first, last, f);
+}
+
+template <typename InputIt, typename OutputIt, typename UnaryOperation>
+OutputIt transform(const parallel_policy&, InputIt first, InputIt last, OutputIt d_first, UnaryOperation op) {
+    return estl::transform(first, last, d_first, op);
+}
+
+template <typename InputIt, typename UnaryPredicate>
+typename iterator_traits<InputIt>::difference_type
+count_if(const parallel_policy&, InputIt first, InputIt last, UnaryPredicate p) {
+    return estl::count_if(first, last, p);
+}
+
+#endif // ESTL_HAS_ATOMIC
+
+} // namespace estl
+
+#endif // ESTL_EXECUTION_HPP
@@ -0,0 +1,457 @@
+#ifndef ESTL_FIXED_STRING_HPP
+#define ESTL_FIXED_STRING_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+#include "hash.hpp"
+#include "charconv.hpp"
+#include "string_view.hpp"
+
+namespace estl {
+
+/**
+ * @brief A string of up to N characters stored inline
+ *
+ * The characters and a terminator live in the object itself; there is no
+ * small-string switch and no allocator, so sizeof is N + 1 characters plus
+ * the smallest integer able to count to N. Appends copy whole ranges with
+ * memcpy and check the capacity once per call, not per character. Text
+ * beyond N characters is truncated, as snprintf would; data() is always
+ * null-terminated.
+ *
+ * A string made from a literal in a constexpr context is built at compile
+ * time. The string converts to basic_string_view for searching and
+ * comparison; append_number() formats integers and append_fixed()
+ * floating-point values in place with to_chars:
+ *
+ *   estl::fixed_string<64> line("T=");
+ *   line.append_fixed(temperature, 2).append(" C");
+ *   uart_write(line.data(), line.size());
+ *
+ * @tparam CharT The character type
+ * @tparam N The maximum number of characters, excluding the terminator
+ */
+template <typename CharT, size_t N>
+class basic_fixed_string {
+    using length_type = typename detail::capacity_size_type<N>::type;
+
+public:
+    // Type definitions
+    using value_type = CharT;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = estl::reverse_iterator<iterator>;
+    using const_reverse_iterator = estl::reverse_iterator<const_iterator>;
+    using view_type = basic_string_view<CharT>;
+
+    static constexpr size_type npos = view_type::npos;
+
+    // Constructors
+    // Only the constexpr constructors clear the unused characters
+    constexpr basic_fixed_string() : m_data(), m_size(0) {}
+
+    // From a literal (or a character array holding a null-terminated string)
+    template <size_t M>
+    constexpr basic_fixed_string(const CharT (&str)[M])
+        : basic_fixed_string(str, detail::make_index_sequence<M - 1>()) {
+        static_assert(M - 1 <= N, "fixed_string literal longer than the capacity");
+    }
+
+    basic_fixed_string(const_pointer str, size_type count) : m_size(0) {
+        append(str, count);
+    }
+
+    explicit basic_fixed_string(view_type view) : m_size(0) {
+        append(view);
+    }
+
+    basic_fixed_string(size_type count, CharT ch) : m_size(0) {
+        append(count, ch);
+    }
+
+    // Assignment
+    basic_fixed_string& operator=(view_type view) {
+        return assign(view);
+    }
+
+    template <size_t M>
+    basic_fixed_string& operator=(const CharT (&str)[M]) {
+        return assign(view_type(str));
+    }
+
+    basic_fixed_string& assign(view_type view) {
+        m_size = 0;
+        return append(view);
+    }
+
+    // Element access
+    reference operator[](size_type pos) {
+        ESTL_ASSERT(pos < m_size);
+        return m_data[pos];
+    }
+
+    const_reference operator[](size_type pos) const {
+        ESTL_ASSERT(pos < m_size);
+        return m_data[pos];
+    }
+
+    reference front() {
+        ESTL_ASSERT(m_size > 0);
+        return m_data[0];
+    }
+
+    const_reference front() const {
+        ESTL_ASSERT(m_size > 0);
+        return m_data[0];
+    }
+
+    reference back() {
+        ESTL_ASSERT(m_size > 0);
+        return m_data[m_size - 1];
+    }
+
+    const_reference back() const {
+        ESTL_ASSERT(m_size > 0);
+        return m_data[m_size - 1];
+    }
+
+    constexpr const_pointer data() const {
+        return m_data;
+    }
+
+    pointer data() {
+        return m_data;
+    }
+
+    constexpr const_pointer c_str() const {
+        return m_data;
+    }
+
+    constexpr view_type view() const {
+        return view_type(m_data, m_size);
+    }
+
+    constexpr operator view_type() const {
+        return view();
+    }
+
+    // Iterators
+    iterator begin() {
+        return m_data;
+    }
+
+    constexpr const_iterator begin() const {
+        return m_data;
+    }
+
+    iterator end() {
+        return m_data + m_size;
+    }
+
+    constexpr const_iterator end() const {
+        return m_data + m_size;
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+    constexpr bool empty() const {
+        return m_size == 0;
+    }
+
+    constexpr bool full() const {
+        return m_size == N;
+    }
+
+    constexpr size_type size() const {
+        return m_size;
+    }
+
+    constexpr size_type length() const {
+        return m_size;
+    }
+
+    constexpr size_type max_size() const {
+        return N;
+    }
+
+    constexpr size_type capacity() const {
+        return N;
+    }
+
+    // Characters that can still be appended
+    constexpr size_type available() const {
+        return N - m_size;
+    }
+
+    // Modifiers
+    void clear() {
+        set_size(0);
+    }
+
+    void push_back(CharT ch) {
+        if (m_size < N) {
+            m_data[m_size] = ch;
+            set_size(m_size + 1u);
+        }
+    }
+
+    void pop_back() {
+        ESTL_ASSERT(m_size > 0);
+        set_size(m_size - 1u);
+    }
+
+    // Appends as much of [str, str + count) as fits, in one copy
+    basic_fixed_string& append(const_pointer str, size_type count) {
+        if (count > available()) {
+            count = available();
+        }
+        std::memcpy(m_data + m_size, str, count * sizeof(CharT));
+        set_size(m_size + count);
+        return *this;
+    }
+
+    basic_fixed_string& append(view_type view) {
+        return append(view.data(), view.size());
+    }
+
+    basic_fixed_string& append(size_type count, CharT ch) {
+        if (count > available()) {
+            count = available();
+        }
+        for (size_type i = 0; i < count; ++i) {
+            m_data[m_size + i] = ch;
+        }
+        set_size(m_size + count);
+        return *this;
+    }
+
+    basic_fixed_string& operator+=(view_type view) {
+        return append(view);
+    }
+
+    basic_fixed_string& operator+=(CharT ch) {
+        push_back(ch);
+        return *this;
+    }
+
+    /**
+     * @brief Appends an integer in the given base, without snprintf
+     *
+     * Appends nothing if the digits do not fit.
+     */
+    template <typename Integer, typename = typename std::enable_if<
+                  std::is_integral<Integer>::value && !std::is_same<Integer, bool>::value>::type>
+    basic_fixed_string& append_number(Integer value, int base = 10) {
+        static_assert(std::is_same<CharT, char>::value, "append_number needs a char string");
+        to_chars_result result = estl::to_chars(m_data + m_size, m_data + N, value, base);
+        if (result.ok) {
+            set_size(static_cast<size_type>(result.ptr - m_data));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Appends value with precision digits after the point
+     *
+     * Below 1e18 the digits are those "%.*f" prints, ties rounding to even;
+     * larger values use exponent form (see to_chars). Named apart from
+     * append_number() so an integer argument cannot take the precision for
+     * a base. Appends nothing if the digits do not fit.
+     */
+    basic_fixed_string& append_fixed(double value, int precision = 6) {
+        static_assert(std::is_same<CharT, char>::value, "append_fixed needs a char string");
+        to_chars_result result = estl::to_chars(m_data + m_size, m_data + N, value, precision);
+        if (result.ok) {
+            set_size(static_cast<size_type>(result.ptr - m_data));
+        }
+        return *this;
+    }
+
+    // Shortens the string or pads it with ch
+    void resize(size_type count, CharT ch = CharT()) {
+        if (count > m_size) {
+            append(count - m_size, ch);
+        } else {
+            set_size(count);
+        }
+    }
+
+    void swap(basic_fixed_string& other) {
+        basic_fixed_string tmp(*this);
+        *this = other;
+        other = tmp;
+    }
+
+    // Operations
+    basic_fixed_string substr(size_type pos, size_type count = npos) const {
+        return basic_fixed_string(view().substr(pos, count));
+    }
+
+    int compare(view_type other) const {
+        return view().compare(other);
+    }
+
+    bool starts_with(view_type prefix) const {
+        return view().starts_with(prefix);
+    }
+
+    bool ends_with(view_type suffix) const {
+        return view().ends_with(suffix);
+    }
+
+    size_type find(CharT ch, size_type pos = 0) const {
+        return view().find(ch, pos);
+    }
+
+    size_type find(view_type str, size_type pos = 0) const {
+        return view().find(str, pos);
+    }
+
+    size_type rfind(CharT ch, size_type pos = npos) const {
+        return view().rfind(ch, pos);
+    }
+
+private:
+    template <size_t... I>
+    constexpr basic_fixed_string(const CharT (&str)[sizeof...(I) + 1], detail::index_sequence<I...>)
+        : m_data{ str[I]... }, m_size(static_cast<length_type>(detail::string_length(str))) {}
+
+    void set_size(size_type size) {
+        m_size = static_cast<length_type>(size);
+        m_data[size] = CharT();
+    }
+
+    CharT m_data[N + 1];
+    length_type m_size;
+};
+
+template <typename CharT, size_t N>
+constexpr typename basic_fixed_string<CharT, N>::size_type basic_fixed_string<CharT, N>::npos;
+
+template <size_t N>
+using fixed_string = basic_fixed_string<char, N>;
+
+namespace detail {
+
+template <typename T>
+struct is_fixed_string : std::false_type {};
+
+template <typename CharT, size_t N>
+struct is_fixed_string<basic_fixed_string<CharT, N>> : std::true_type {};
+
+// Enables the comparisons of a fixed_string with anything that converts
+// to a view: another fixed_string, a string_view or a literal
+template <typename CharT, typename Other>
+using fixed_string_comparable = typename std::enable_if<
+    std::is_convertible<const Other&, basic_string_view<CharT>>::value, bool>::type;
+
+template <typename CharT, typename Other>
+using fixed_string_reverse_comparable = typename std::enable_if<
+    !is_fixed_string<Other>::value && std::is_convertible<const Other&, basic_string_view<CharT>>::value,
+    bool>::type;
+
+} // namespace detail
+
+// Non-member functions
+template <typename CharT, size_t N, typename Other>
+detail::fixed_string_comparable<CharT, Other> operator==(const basic_fixed_string<CharT, N>& lhs, const Other& rhs) {
+    return lhs.view() == basic_string_view<CharT>(rhs);
+}
+
+template <typename CharT, size_t N, typename Other>
+detail::fixed_string_comparable<CharT, Other> operator!=(const basic_fixed_string<CharT, N>& lhs, const Other& rhs) {
+    return lhs.view() != basic_string_view<CharT>(rhs);
+}
+
+template <typename CharT, size_t N, typename Other>
+detail::fixed_string_comparable<CharT, Other> operator<(const basic_fixed_string<CharT, N>& lhs, const Other& rhs) {
+    return lhs.view() < basic_string_view<CharT>(rhs);
+}
+
+template <typename CharT, size_t N, typename Other>
+detail::fixed_string_comparable<CharT, Other> operator<=(const basic_fixed_string<CharT, N>& lhs, const Other& rhs) {
+    return lhs.view() <= basic_string_view<CharT>(rhs);
+}
+
+template <typename CharT, size_t N, typename Other>
+detail::fixed_string_comparable<CharT, Other> operator>(const basic_fixed_string<CharT, N>& lhs, const Other& rhs) {
+    return lhs.view() > basic_string_view<CharT>(rhs);
+}
+
+template <typename CharT, size_t N, typename Other>
+detail::fixed_string_comparable<CharT, Other> operator>=(const basic_fixed_string<CharT, N>& lhs, const Other& rhs) {
+    return lhs.view() >= basic_string_view<CharT>(rhs);
+}
+
+template <typename Other, typename CharT, size_t N>
+detail::fixed_string_reverse_comparable<CharT, Other> operator==(const Other& lhs, const basic_fixed_string<CharT, N>& rhs) {
+    return basic_string_view<CharT>(lhs) == rhs.view();
+}
+
+template <typename Other, typename CharT, size_t N>
+detail::fixed_string_reverse_comparable<CharT, Other> operator!=(const Other& lhs, const basic_fixed_string<CharT, N>& rhs) {
+    return basic_string_view<CharT>(lhs) != rhs.view();
+}
+
+template <typename Other, typename CharT, size_t N>
+detail::fixed_string_reverse_comparable<CharT, Other> operator<(const Other& lhs, const basic_fixed_string<CharT, N>& rhs) {
+    return basic_string_view<CharT>(lhs) < rhs.view();
+}
+
+template <typename Other, typename CharT, size_t N>
+detail::fixed_string_reverse_comparable<CharT, Other> operator<=(const Other& lhs, const basic_fixed_string<CharT, N>& rhs) {
+    return basic_string_view<CharT>(lhs) <= rhs.view();
+}
+
+template <typename Other, typename CharT, size_t N>
+detail::fixed_string_reverse_comparable<CharT, Other> operator>(const Other& lhs, const basic_fixed_string<CharT, N>& rhs) {
+    return basic_string_view<CharT>(lhs) > rhs.view();
+}
+
+template <typename Other, typename CharT, size_t N>
+detail::fixed_string_reverse_comparable<CharT, Other> operator>=(const Other& lhs, const basic_fixed_string<CharT, N>& rhs) {
+    return basic_string_view<CharT>(lhs) >= rhs.view();
+}
+
+template <typename CharT, size_t N>
+void swap(basic_fixed_string<CharT, N>& lhs, basic_fixed_string<CharT, N>& rhs) {
+    lhs.swap(rhs);
+}
+
+// Hashes like the equal string_view, so both can look up the same keys
+template <typename CharT, size_t N>
+struct hash<basic_fixed_string<CharT, N>> {
+    size_t operator()(const basic_fixed_string<CharT, N>& value) const {
+        return hash<basic_string_view<CharT>>()(value.view());
+    }
+};
+
+} // namespace estl
+
+#endif // ESTL_FIXED_STRING_HPP
@@ -0,0 +1,549 @@
+#ifndef ESTL_FLAT_MAP_HPP
+#define ESTL_FLAT_MAP_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Parallel key and value arrays for flat_map; entry i of each belongs to the
+// same element
+template <typename Key, typename T, size_t Capacity>
+struct split_buffer_base {
+    constexpr split_buffer_base() : m_keys(), m_values(), m_size(0) {}
+
+    Key* keys() {
+        return reinterpret_cast<Key*>(m_keys.m_bytes);
+    }
+
+    const Key* keys() const {
+        return reinterpret_cast<const Key*>(m_keys.m_bytes);
+    }
+
+    T* values() {
+        return reinterpret_cast<T*>(m_values.m_bytes);
+    }
+
+    const T* values() const {
+        return reinterpret_cast<const T*>(m_values.m_bytes);
+    }
+
+    inline_storage<Key, Capacity> m_keys;
+    inline_storage<T, Capacity> m_values;
+    typename capacity_size_type<Capacity>::type m_size;
+};
+
+template <typename Key, typename T, size_t Capacity,
+          bool = std::is_trivially_destructible<Key>::value && std::is_trivially_destructible<T>::value>
+struct split_buffer : split_buffer_base<Key, T, Capacity> {
+    constexpr split_buffer() : split_buffer_base<Key, T, Capacity>() {}
+};
+
+template <typename Key, typename T, size_t Capacity>
+struct split_buffer<Key, T, Capacity, false> : split_buffer_base<Key, T, Capacity> {
+    constexpr split_buffer() : split_buffer_base<Key, T, Capacity>() {}
+
+    ~split_buffer() {
+        destroy(this->keys(), this->keys() + this->m_size);
+        destroy(this->values(), this->values() + this->m_size);
+    }
+};
+
+// operator-> of an iterator whose reference is a proxy: holds the proxy so
+// it->first and it->second work
+template <typename Reference>
+struct arrow_proxy {
+    Reference m_ref;
+
+    Reference* operator->() {
+        return &m_ref;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A sorted associative container with keys and values in separate arrays
+ *
+ * Same interface as estl::map, but keys and mapped values are stored in two
+ * parallel arrays instead of one array of pairs. Lookups only ever touch the
+ * dense key array, so searching a map of large values costs no more cache
+ * traffic than searching an array of keys.
+ *
+ * Because no std::pair exists in memory, iterators dereference to a
+ * std::pair<const Key&, T&> proxy: it->first and (*it).second work as for
+ * map, but &*it does not, and neither does operator-> on reverse iterators.
+ * keys() and values() expose the arrays directly.
+ *
+ * @tparam Key The type of keys
+ * @tparam T The type of mapped values
+ * @tparam Compare The comparison function object type
+ * @tparam Capacity The maximum number of elements (static allocation)
+ */
+template <
+    typename Key,
+    typename T,
+    typename Compare = less<Key>,
+    size_t Capacity = 16
+>
+class flat_map : private detail::split_buffer<Key, T, Capacity> {
+    using storage_base = detail::split_buffer<Key, T, Capacity>;
+    using storage_base::m_size;
+
+public:
+    // Type definitions
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using key_compare = Compare;
+    using reference = std::pair<const Key&, T&>;
+    using const_reference = std::pair<const Key&, const T&>;
+
+    class iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = std::pair<Key, T>;
+        using difference_type = ptrdiff_t;
+        using reference = std::pair<const Key&, T&>;
+        using pointer = detail::arrow_proxy<reference>;
+
+        iterator() : m_ptr(nullptr), m_index(0) {}
+        iterator(flat_map* map_ptr, size_type index) : m_ptr(map_ptr), m_index(index) {}
+
+        reference operator*() const {
+            return reference(m_ptr->keys()[m_index], m_ptr->values()[m_index]);
+        }
+
+        pointer operator->() const {
+            pointer proxy = { **this };
+            return proxy;
+        }
+
+        iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        iterator& operator--() {
+            --m_index;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return m_ptr == other.m_ptr && m_index == other.m_index;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        flat_map* m_ptr;
+        size_type m_index;
+
+        friend class flat_map;
+        friend class const_iterator;
+    };
+
+    class const_iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = std::pair<Key, T>;
+        using difference_type = ptrdiff_t;
+        using reference = std::pair<const Key&, const T&>;
+        using pointer = detail::arrow_proxy<reference>;
+
+        const_iterator() : m_ptr(nullptr), m_index(0) {}
+        const_iterator(const flat_map* map_ptr, size_type index) : m_ptr(map_ptr), m_index(index) {}
+        const_iterator(const iterator& it) : m_ptr(it.m_ptr), m_index(it.m_index) {}
+
+        reference operator*() const {
+            return reference(m_ptr->keys()[m_index], m_ptr->values()[m_index]);
+        }
+
+        pointer operator->() const {
+            pointer proxy = { **this };
+            return proxy;
+        }
+
+        const_iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator& operator--() {
+            --m_index;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_ptr == other.m_ptr && m_index == other.m_index;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const flat_map* m_ptr;
+        size_type m_index;
+
+        friend class flat_map;
+    };
+
+    using reverse_iterator = estl::reverse_iterator<iterator>;
+    using const_reverse_iterator = estl::reverse_iterator<const_iterator>;
+
+    // Constructors
+    constexpr flat_map() : storage_base() {}
+
+    flat_map(const flat_map& other) : storage_base() {
+        copy_elements(other);
+    }
+
+    // Assignment operator
+    flat_map& operator=(const flat_map& other) {
+        if (this != &other) {
+            clear();
+            copy_elements(other);
+        }
+        return *this;
+    }
+
+    // Element access
+    T& at(const Key& key) {
+        size_type index = find_index(key);
+        ESTL_ASSERT(index != m_size);
+        return values()[index];
+    }
+
+    const T& at(const Key& key) const {
+        size_type index = find_index(key);
+        ESTL_ASSERT(index != m_size);
+        return values()[index];
+    }
+
+    T& operator[](const Key& key) {
+        size_type pos = lower_index(key);
+        if (pos < m_size && !key_comp()(key, keys()[pos])) {
+            return values()[pos];
+        }
+
+        // A new key needs room, asserted like the key of at(); insert
+        // reports a full map instead
+        if (m_size >= Capacity) {
+            ESTL_ASSERT(m_size < Capacity);
+            return values()[m_size];
+        }
+
+        // Insert new element with default value
+        insert_at(pos, key, T());
+        return values()[pos];
+    }
+
+    // Direct access to the sorted key array and the parallel value array
+    const Key* keys() const {
+        return storage_base::keys();
+    }
+
+    T* values() {
+        return storage_base::values();
+    }
+
+    const T* values() const {
+        return storage_base::values();
+    }
+
+    // Iterators
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, m_size);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, m_size);
+    }
+
+    const_iterator cend() const {
+        return const_iterator(this, m_size);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    size_type max_size() const {
+        return Capacity;
+    }
+
+    // Modifiers
+    void clear() {
+        destroy(keys_data(), keys_data() + m_size);
+        destroy(values(), values() + m_size);
+        m_size = 0;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        size_type pos = lower_index(value.first);
+        if (pos < m_size && !key_comp()(value.first, keys()[pos])) {
+            return std::make_pair(iterator(this, pos), false);
+        }
+
+        if (m_size >= Capacity) {
+            ESTL_ASSERT(m_size < Capacity);
+            return std::make_pair(end(), false);
+        }
+
+        insert_at(pos, value.first, value.second);
+        return std::make_pair(iterator(this, pos), true);
+    }
+
+    iterator erase(const_iterator pos) {
+        size_type index = pos.m_index;
+
+        keys_data()[index].~Key();
+        values()[index].~T();
+        detail::relocate_down(keys_data(), index, m_size);
+        detail::relocate_down(values(), index, m_size);
+
+        --m_size;
+        return iterator(this, index);
+    }
+
+    size_type erase(const Key& key) {
+        size_type index = find_index(key);
+        if (index == m_size) {
+            return 0;
+        }
+
+        erase(const_iterator(this, index));
+        return 1;
+    }
+
+    void swap(flat_map& other) {
+        size_type min_size = (m_size < other.m_size) ? m_size : other.m_size;
+
+        // Keys are stored non-const, so the common prefix swaps in place
+        for (size_type i = 0; i < min_size; ++i) {
+            using std::swap;
+            swap(keys_data()[i], other.keys_data()[i]);
+            swap(values()[i], other.values()[i]);
+        }
+
+        // The tail of the larger map moves across
+        flat_map& larger = (m_size > min_size) ? *this : other;
+        flat_map& smaller = (m_size > min_size) ? other : *this;
+        uninitialized_move(larger.keys_data() + min_size, larger.keys_data() + larger.m_size,
+                           smaller.keys_data() + min_size);
+        uninitialized_move(larger.values() + min_size, larger.values() + larger.m_size,
+                           smaller.values() + min_size);
+        destroy(larger.keys_data() + min_size, larger.keys_data() + larger.m_size);
+        destroy(larger.values() + min_size, larger.values() + larger.m_size);
+
+        size_type temp_size = m_size;
+        m_size = other.m_size;
+        other.m_size = temp_size;
+    }
+
+    // Lookup
+    size_type count(const Key& key) const {
+        return (find_index(key) != m_size) ? 1 : 0;
+    }
+
+    iterator find(const Key& key) {
+        return iterator(this, find_index(key));
+    }
+
+    const_iterator find(const Key& key) const {
+        return const_iterator(this, find_index(key));
+    }
+
+    std::pair<iterator, iterator> equal_range(const Key& key) {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    iterator lower_bound(const Key& key) {
+        return iterator(this, lower_index(key));
+    }
+
+    const_iterator lower_bound(const Key& key) const {
+        return const_iterator(this, lower_index(key));
+    }
+
+    iterator upper_bound(const Key& key) {
+        return iterator(this, upper_index(key));
+    }
+
+    const_iterator upper_bound(const Key& key) const {
+        return const_iterator(this, upper_index(key));
+    }
+
+    // Observers
+    key_compare key_comp() const {
+        return Compare();
+    }
+
+private:
+    // Mutable key access is kept private: client code must not reorder keys
+    Key* keys_data() {
+        return storage_base::keys();
+    }
+
+    // Index of the first key not less than key; searches the key array only,
+    // without branching on the comparisons
+    size_type lower_index(const Key& key) const {
+        return static_cast<size_type>(detail::branchless_lower_bound(keys(), m_size, key, Compare()) - keys());
+    }
+
+    size_type upper_index(const Key& key) const {
+        return static_cast<size_type>(detail::branchless_upper_bound(keys(), m_size, key, Compare()) - keys());
+    }
+
+    // Index of key, or m_size when absent
+    size_type find_index(const Key& key) const {
+        size_type index = lower_index(key);
+        if (index < m_size && !key_comp()(key, keys()[index])) {
+            return index;
+        }
+        return m_size;
+    }
+
+    // Opens a gap at pos in both arrays and constructs the new element there
+    template <typename K, typename V>
+    void insert_at(size_type pos, K&& key, V&& value) {
+        detail::relocate_up(keys_data(), pos, m_size);
+        detail::relocate_up(values(), pos, m_size);
+        new (&keys_data()[pos]) Key(std::forward<K>(key));
+        new (&values()[pos]) T(std::forward<V>(value));
+        ++m_size;
+    }
+
+    void copy_elements(const flat_map& other) {
+        uninitialized_copy(other.keys(), other.keys() + other.m_size, keys_data());
+        uninitialized_copy(other.values(), other.values() + other.m_size, values());
+        m_size = other.m_size;
+    }
+
+    friend class iterator;
+    friend class const_iterator;
+};
+
+// Non-member functions
+template <typename Key, typename T, typename Compare, size_t Capacity>
+bool operator==(const flat_map<Key, T, Compare, Capacity>& lhs, const flat_map<Key, T, Compare, Capacity>& rhs) {
+    return lhs.size() == rhs.size() &&
+           estl::equal(lhs.keys(), lhs.keys() + lhs.size(), rhs.keys()) &&
+           estl::equal(lhs.values(), lhs.values() + lhs.size(), rhs.values());
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity>
+bool operator!=(const flat_map<Key, T, Compare, Capacity>& lhs, const flat_map<Key, T, Compare, Capacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity>
+bool operator<(const flat_map<Key, T, Compare, Capacity>& lhs, const flat_map<Key, T, Compare, Capacity>& rhs) {
+    return estl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity>
+bool operator<=(const flat_map<Key, T, Compare, Capacity>& lhs, const flat_map<Key, T, Compare, Capacity>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity>
+bool operator>(const flat_map<Key, T, Compare, Capacity>& lhs, const flat_map<Key, T, Compare, Capacity>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity>
+bool operator>=(const flat_map<Key, T, Compare, Capacity>& lhs, const flat_map<Key, T, Compare, Capacity>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t Capacity>
+void swap(flat_map<Key, T, Compare, Capacity>& lhs, flat_map<Key, T, Compare, Capacity>& rhs) {
+    lhs.swap(rhs);
+}
+
+} // namespace estl
+
+#endif // ESTL_FLAT_MAP_HPP
@@ -0,0 +1,288 @@
+#ifndef ESTL_FROZEN_MAP_HPP
+#define ESTL_FROZEN_MAP_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "algorithm.hpp"
+#include "utility.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Permutation of the source items into key order
+template <size_t N>
+struct frozen_order {
+    size_t index[N];
+};
+
+// Not constexpr: reaching it during constant evaluation stops compilation
+// with this name in the diagnostic
+inline size_t duplicate_key_in_frozen_map() {
+    ESTL_ASSERT(false);
+    return 0;
+}
+
+#if ESTL_HAS_CONSTEXPR14
+
+// Insertion sort of the item indices: O(N^2) compile-time steps
+template <typename V, size_t N, typename Compare>
+constexpr frozen_order<N> make_frozen_order(const V (&items)[N], Compare comp) {
+    frozen_order<N> order{};
+    for (size_t i = 0; i < N; ++i) {
+        size_t j = i;
+        for (; j > 0 && comp(items[i].first, items[order.index[j - 1]].first); --j) {
+            order.index[j] = order.index[j - 1];
+        }
+        order.index[j] = i;
+    }
+    for (size_t i = 1; i < N; ++i) {
+        if (!comp(items[order.index[i - 1]].first, items[order.index[i]].first)) {
+            duplicate_key_in_frozen_map();
+        }
+    }
+    return order;
+}
+
+#else
+
+// C++11 constexpr functions are single expressions, so the sort is done
+// by ranking: each item's position is the number of keys before it. The
+// recursions split ranges in half to keep constexpr depth at O(log N).
+
+// Number of items in [lo, hi) whose key orders before key
+template <typename V, typename K, typename Compare>
+constexpr size_t frozen_rank(const V* items, size_t lo, size_t hi, const K& key, Compare comp) {
+    return (hi - lo == 1)
+        ? (comp(items[lo].first, key) ? 1 : 0)
+        : frozen_rank(items, lo, lo + (hi - lo) / 2, key, comp) +
+          frozen_rank(items, lo + (hi - lo) / 2, hi, key, comp);
+}
+
+// Index in [lo, hi) holding rank, or none if no item has that rank
+constexpr size_t frozen_position(const size_t* ranks, size_t lo, size_t hi, size_t rank, size_t none);
+
+constexpr size_t frozen_position_or(size_t found, const size_t* ranks, size_t lo, size_t hi,
+                                    size_t rank, size_t none) {
+    return found != none ? found : frozen_position(ranks, lo, hi, rank, none);
+}
+
+constexpr size_t frozen_position(const size_t* ranks, size_t lo, size_t hi, size_t rank, size_t none) {
+    return (hi - lo == 1)
+        ? (ranks[lo] == rank ? lo : none)
+        : frozen_position_or(frozen_position(ranks, lo, lo + (hi - lo) / 2, rank, none),
+                             ranks, lo + (hi - lo) / 2, hi, rank, none);
+}
+
+// Equal keys share a rank, which leaves some rank without an item
+constexpr size_t frozen_checked(size_t position, size_t none) {
+    return position != none ? position : duplicate_key_in_frozen_map();
+}
+
+template <typename V, size_t N, typename Compare, size_t... I>
+constexpr frozen_order<N> frozen_ranks(const V (&items)[N], Compare comp, index_sequence<I...>) {
+    return frozen_order<N>{{ frozen_rank(items, 0, N, items[I].first, comp)... }};
+}
+
+template <size_t N, size_t... I>
+constexpr frozen_order<N> frozen_invert(const frozen_order<N>& ranks, index_sequence<I...>) {
+    return frozen_order<N>{{ frozen_checked(frozen_position(ranks.index, 0, N, I, N), N)... }};
+}
+
+// O(N^2) compile-time steps
+template <typename V, size_t N, typename Compare>
+constexpr frozen_order<N> make_frozen_order(const V (&items)[N], Compare comp) {
+    return frozen_invert(frozen_ranks(items, comp, make_index_sequence<N>()), make_index_sequence<N>());
+}
+
+#endif
+
+// Integer keys in natural order that cover a contiguous range can be looked
+// up by offset instead of by search
+template <typename Key, typename Compare>
+struct is_dense_indexable
+    : std::integral_constant<bool, std::is_integral<Key>::value && std::is_same<Compare, less<Key>>::value> {};
+
+template <typename Key>
+constexpr unsigned long long key_offset(const Key& key, const Key& first) {
+    return static_cast<unsigned long long>(key) - static_cast<unsigned long long>(first);
+}
+
+} // namespace detail
+
+/**
+ * @brief An immutable sorted map built at compile time
+ *
+ * Initialized from a braced list in any order; the elements are sorted
+ * during constant evaluation, so a constexpr frozen_map is emitted as a
+ * ready-made table in .rodata (flash) with no boot-time initialization and
+ * no RAM. Lookups are binary searches, or a direct offset when the keys are
+ * integers forming a contiguous range (e.g. command IDs 0..N-1).
+ *
+ * Usage:
+ *   constexpr auto handlers = estl::make_frozen_map<uint8_t, handler_fn>({
+ *       {0x10, &on_reset}, {0x02, &on_status}, {0x07, &on_read}});
+ *
+ * Duplicate keys fail compilation in duplicate_key_in_frozen_map. With
+ * C++14 or later (CMAKE_CXX_STANDARD) the sort is a constexpr insertion
+ * sort; C++11 builds rank the elements with recursive constexpr functions,
+ * which costs more compile time for large tables.
+ *
+ * @tparam Key The type of keys
+ * @tparam T The type of mapped values
+ * @tparam N The number of elements
+ * @tparam Compare The comparison function object type, constexpr-callable
+ */
+template <typename Key, typename T, size_t N, typename Compare = less<Key>>
+class frozen_map {
+    static_assert(N > 0, "frozen_map needs at least one element");
+
+public:
+    // Type definitions
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using key_compare = Compare;
+    using const_reference = const value_type&;
+    using const_pointer = const value_type*;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    // Constructors
+    constexpr frozen_map(const value_type (&items)[N])
+        : frozen_map(items, detail::make_frozen_order(items, Compare()), detail::make_index_sequence<N>()) {}
+
+    // Element access
+    constexpr const T& at(const Key& key) const {
+        return checked(find(key))->second;
+    }
+
+    // Iterators
+    constexpr const_iterator begin() const {
+        return m_items;
+    }
+
+    constexpr const_iterator cbegin() const {
+        return m_items;
+    }
+
+    constexpr const_iterator end() const {
+        return m_items + N;
+    }
+
+    constexpr const_iterator cend() const {
+        return m_items + N;
+    }
+
+    // Capacity
+    constexpr bool empty() const {
+        return false;
+    }
+
+    constexpr size_type size() const {
+        return N;
+    }
+
+    constexpr size_type max_size() const {
+        return N;
+    }
+
+    // Lookup
+    constexpr size_type count(const Key& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    constexpr const_iterator find(const Key& key) const {
+        return match(key, m_dense ? dense_index(key, detail::is_dense_indexable<Key, Compare>())
+                                  : lower_index(key, 0, N));
+    }
+
+    constexpr const_iterator lower_bound(const Key& key) const {
+        return m_items + lower_index(key, 0, N);
+    }
+
+    constexpr const_iterator upper_bound(const Key& key) const {
+        return m_items + upper_index(key, 0, N);
+    }
+
+    constexpr std::pair<const_iterator, const_iterator> equal_range(const Key& key) const {
+        return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    // Whether lookups use the direct offset instead of a search
+    constexpr bool dense() const {
+        return m_dense;
+    }
+
+    // Observers
+    constexpr key_compare key_comp() const {
+        return Compare();
+    }
+
+private:
+    template <size_t... I>
+    constexpr frozen_map(const value_type (&items)[N], const detail::frozen_order<N>& order,
+                         detail::index_sequence<I...>)
+        : m_items{ items[order.index[I]]... },
+          m_dense(is_dense(items[order.index[0]].first, items[order.index[N - 1]].first,
+                           detail::is_dense_indexable<Key, Compare>())) {}
+
+    static constexpr bool is_dense(const Key& first, const Key& last, std::true_type) {
+        return detail::key_offset(last, first) == N - 1;
+    }
+
+    static constexpr bool is_dense(const Key&, const Key&, std::false_type) {
+        return false;
+    }
+
+    constexpr size_type dense_index(const Key& key, std::true_type) const {
+        return (key < m_items[0].first || m_items[N - 1].first < key)
+            ? N : static_cast<size_type>(detail::key_offset(key, m_items[0].first));
+    }
+
+    constexpr size_type dense_index(const Key&, std::false_type) const {
+        return N;
+    }
+
+    // Binary searches as recursions, usable from C++11 constexpr
+    constexpr size_type lower_index(const Key& key, size_type lo, size_type hi) const {
+        return lo == hi ? lo
+            : Compare()(m_items[lo + (hi - lo) / 2].first, key)
+                ? lower_index(key, lo + (hi - lo) / 2 + 1, hi)
+                : lower_index(key, lo, lo + (hi - lo) / 2);
+    }
+
+    constexpr size_type upper_index(const Key& key, size_type lo, size_type hi) const {
+        return lo == hi ? lo
+            : Compare()(key, m_items[lo + (hi - lo) / 2].first)
+                ? upper_index(key, lo, lo + (hi - lo) / 2)
+                : upper_index(key, lo + (hi - lo) / 2 + 1, hi);
+    }
+
+    constexpr const_iterator match(const Key& key, size_type index) const {
+        return (index < N && !Compare()(key, m_items[index].first)) ? m_items + index : end();
+    }
+
+    constexpr const_iterator checked(const_iterator it) const {
+        return (ESTL_ASSERT(it != end()), it);
+    }
+
+    value_type m_items[N];
+    bool m_dense;
+};
+
+/**
+ * @brief Builds a frozen_map, deducing N from the braced list
+ */
+template <typename Key, typename T, typename Compare = less<Key>, size_t N>
+constexpr frozen_map<Key, T, N, Compare> make_frozen_map(const std::pair<const Key, T> (&items)[N]) {
+    return frozen_map<Key, T, N, Compare>(items);
+}
+
+} // namespace estl
+
+#endif // ESTL_FROZEN_MAP_HPP
@@ -0,0 +1,68 @@
+#ifndef ESTL_HASH_HPP
+#define ESTL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "config.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Folds a 64-bit value into size_t without discarding the upper half
+inline size_t fold_to_size(unsigned long long value) {
+    return (sizeof(size_t) >= sizeof(unsigned long long))
+        ? static_cast<size_t>(value)
+        : static_cast<size_t>(value ^ (value >> 32));
+}
+
+// 32-bit FNV-1a, continued from value over a byte range; start with
+// fnv1a_basis to hash data that arrives in pieces
+constexpr uint32_t fnv1a_basis = 2166136261u;
+
+inline uint32_t fnv1a(uint32_t value, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        value ^= bytes[i];
+        value *= 16777619u;
+    }
+    return value;
+}
+
+// For keys that are not a single integer
+inline size_t hash_bytes(const void* data, size_t size) {
+    return static_cast<size_t>(fnv1a(fnv1a_basis, data, size));
+}
+
+} // namespace detail
+
+/**
+ * @brief Default hash function object for the unordered containers
+ *
+ * Integral and enum types hash to their own value; the containers mix the
+ * result before reducing it to a slot index, so identity hashes are fine.
+ * Provide a specialization for other key types.
+ *
+ * @tparam T The type to hash
+ */
+template <typename T>
+struct hash {
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                  "estl::hash has no specialization for this type");
+
+    size_t operator()(const T& value) const {
+        return detail::fold_to_size(static_cast<unsigned long long>(value));
+    }
+};
+
+template <typename T>
+struct hash<T*> {
+    size_t operator()(T* value) const {
+        return static_cast<size_t>(reinterpret_cast<uintptr_t>(value));
+    }
+};
+
+} // namespace estl
+
+#endif // ESTL_HASH_HPP
@@ -0,0 +1,406 @@
+#ifndef ESTL_IMAGE_HPP
+#define ESTL_IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "config.hpp"
+#include "algorithm.hpp"
+#include "hash.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+
+namespace estl {
+
+/**
+ * Container images
+ *
+ * A flat, position-independent layout of a vector or map that is used in
+ * place: point a vector_image or map_image at the bytes in memory-mapped
+ * flash (or an mmap'd file on a host) and the elements are read where they
+ * lie, with no parsing, no inserts and no RAM copy. image_writer produces
+ * the layout through a sink, one element at a time, so it can be
+ * programmed into flash page by page.
+ *
+ * Layout, all offsets from the start of the image:
+ *
+ *   image_header                 24 bytes
+ *   padding                      to alignof(T)
+ *   T[count]                     at header.data_offset
+ *   padding                      to 4 bytes
+ *   uint32_t checksum            FNV-1a over everything before it
+ *
+ * The image holds no pointers, so it can be linked or copied to any
+ * address that meets the element alignment. Elements are stored as raw
+ * object bytes and must be trivially copyable; the writer and the reader
+ * must therefore agree on the layout of T. The header records sizeof(T),
+ * alignof(T) and a native-endian magic word, so an image built for another
+ * ABI or byte order is rejected instead of misread.
+ */
+
+// "ESTL" as a native-endian word
+constexpr uint32_t image_magic = 0x4C545345u;
+
+// Bumped whenever the layout changes; readers reject other versions
+constexpr uint16_t image_version = 1;
+
+enum class image_kind : uint16_t {
+    vector = 1,
+    map = 2
+};
+
+struct image_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t kind;
+    uint32_t element_size;
+    uint32_t element_align;
+    uint32_t count;
+    uint32_t data_offset;
+};
+
+// An element of a map image, laid out like the map's value_type
+template <typename Key, typename T>
+struct map_image_entry {
+    Key first;
+    T second;
+};
+
+namespace detail {
+
+inline size_t image_align_up(size_t offset, size_t align) {
+    return (offset + align - 1) / align * align;
+}
+
+inline size_t image_checksum_offset(const image_header& header) {
+    return image_align_up(header.data_offset + static_cast<size_t>(header.count) * header.element_size, 4);
+}
+
+// The elements of a valid image of kind holding T, or nullptr
+template <typename T>
+const T* open_image(const void* image, size_t size, image_kind kind, size_t& count) {
+    static_assert(std::is_trivially_copyable<T>::value, "container images require a trivially copyable T");
+    count = 0;
+    if (image == nullptr || size < sizeof(image_header) ||
+        reinterpret_cast<uintptr_t>(image) % alignof(image_header) != 0) {
+        return nullptr;
+    }
+    const image_header& header = *static_cast<const image_header*>(image);
+    if (header.magic != image_magic || header.version != image_version ||
+        header.kind != static_cast<uint16_t>(kind) || header.element_size != sizeof(T) ||
+        header.element_align != alignof(T) || header.data_offset < sizeof(image_header) || header.data_offset > size ||
+        header.count > (size - header.data_offset) / sizeof(T) ||
+        size < image_checksum_offset(header) + sizeof(uint32_t)) {
+        return nullptr;
+    }
+    const unsigned char* data = static_cast<const unsigned char*>(image) + header.data_offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+        return nullptr;
+    }
+    count = header.count;
+    return reinterpret_cast<const T*>(data);
+}
+
+inline bool verify_image(const void* image) {
+    const image_header& header = *static_cast<const image_header*>(image);
+    size_t offset = image_checksum_offset(header);
+    uint32_t stored;
+    std::memcpy(&stored, static_cast<const unsigned char*>(image) + offset, sizeof(stored));
+    return fnv1a(fnv1a_basis, image, offset) == stored;
+}
+
+} // namespace detail
+
+/**
+ * @brief A read-only view of a vector image
+ *
+ * Opening checks the header in constant time; verify() additionally checks
+ * the checksum, which reads every byte. An image that fails to open gives an
+ * empty view with valid() false.
+ *
+ * @tparam T The element type, as written
+ */
+template <typename T>
+class vector_image {
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using const_reference = const T&;
+    using const_pointer = const T*;
+    using const_iterator = const T*;
+
+    // Constructors
+    constexpr vector_image() : m_image(nullptr), m_size(0), m_data(nullptr) {}
+
+    vector_image(const void* image, size_t size)
+        : m_image(image), m_size(0), m_data(detail::open_image<T>(image, size, image_kind::vector, m_size)) {
+        if (m_data == nullptr) {
+            m_image = nullptr;
+        }
+    }
+
+    bool valid() const {
+        return m_data != nullptr;
+    }
+
+    bool verify() const {
+        return valid() && detail::verify_image(m_image);
+    }
+
+    // Element access
+    const_reference operator[](size_type index) const {
+        ESTL_ASSERT(index < m_size);
+        return m_data[index];
+    }
+
+    const_pointer data() const {
+        return m_data;
+    }
+
+    span<const T> elements() const {
+        return span<const T>(m_data, m_size);
+    }
+
+    // Iterators
+    const_iterator begin() const {
+        return m_data;
+    }
+
+    const_iterator end() const {
+        return m_data + m_size;
+    }
+
+    // Capacity
+    size_type size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+private:
+    const void* m_image;
+    size_type m_size;
+    const T* m_data;
+};
+
+/**
+ * @brief A read-only view of a map image
+ *
+ * The entries are in key order, so lookups are binary searches straight
+ * over the flash contents. Compare must be the ordering the image was
+ * written with, normally that of the source estl::map.
+ */
+template <typename Key, typename T, typename Compare = less<Key>>
+class map_image : private Compare {
+public:
+    // Type definitions
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = map_image_entry<Key, T>;
+    using size_type = size_t;
+    using key_compare = Compare;
+    using const_reference = const value_type&;
+    using const_iterator = const value_type*;
+
+    // Constructors
+    constexpr map_image() : Compare(), m_image(nullptr), m_size(0), m_data(nullptr) {}
+
+    map_image(const void* image, size_t size, const Compare& comp = Compare())
+        : Compare(comp), m_image(image), m_size(0),
+          m_data(detail::open_image<value_type>(image, size, image_kind::map, m_size)) {
+        if (m_data == nullptr) {
+            m_image = nullptr;
+        }
+    }
+
+    bool valid() const {
+        return m_data != nullptr;
+    }
+
+    bool verify() const {
+        return valid() && detail::verify_image(m_image);
+    }
+
+    // Iterators
+    const_iterator begin() const {
+        return m_data;
+    }
+
+    const_iterator end() const {
+        return m_data + m_size;
+    }
+
+    // Capacity
+    size_type size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    // Lookup
+    const_iterator lower_bound(const Key& key) const {
+        return estl::lower_bound(begin(), end(), key, entry_compare(key_comp()));
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        return (it != end() && !key_comp()(key, it->first)) ? it : end();
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    size_type count(const Key& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // The key must be present
+    const T& at(const Key& key) const {
+        const_iterator it = find(key);
+        ESTL_ASSERT(it != end());
+        return it->second;
+    }
+
+    key_compare key_comp() const {
+        return static_cast<const Compare&>(*this);
+    }
+
+private:
+    struct entry_compare {
+        explicit entry_compare(const Compare& comp) : m_comp(comp) {}
+
+        bool operator()(const value_type& entry, const Key& key) const {
+            return m_comp(entry.first, key);
+        }
+
+        Compare m_comp;
+    };
+
+    const void* m_image;
+    size_type m_size;
+    const value_type* m_data;
+};
+
+/**
+ * @brief Streams an image of count elements into a sink
+ *
+ * The sink is called as sink(const void* data, size_t size) for
+ * consecutive pieces of the image and returns false on a write error, e.g.
+ * a failed flash program. The header is written by the constructor, each
+ * push() writes one element and finish() writes the checksum; the image is
+ * only valid once finish() has succeeded.
+ *
+ * @tparam T The element type (map_image_entry for a map image)
+ * @tparam Sink The byte sink
+ */
+template <typename T, typename Sink>
+class image_writer {
+    static_assert(std::is_trivially_copyable<T>::value, "container images require a trivially copyable T");
+
+public:
+    image_writer(Sink& sink, image_kind kind, size_t count)
+        : m_sink(sink), m_checksum(detail::fnv1a_basis), m_offset(0), m_remaining(count), m_ok(true) {
+        image_header header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = image_magic;
+        header.version = image_version;
+        header.kind = static_cast<uint16_t>(kind);
+        header.element_size = sizeof(T);
+        header.element_align = alignof(T);
+        header.count = static_cast<uint32_t>(count);
+        header.data_offset = static_cast<uint32_t>(detail::image_align_up(sizeof(image_header), alignof(T)));
+        write(&header, sizeof(header));
+        pad(header.data_offset);
+    }
+
+    image_writer(const image_writer&) = delete;
+    image_writer& operator=(const image_writer&) = delete;
+
+    // False on a sink error or when count elements were already written
+    bool push(const T& element) {
+        if (m_remaining == 0) {
+            return false;
+        }
+        --m_remaining;
+        return write(&element, sizeof(T));
+    }
+
+    // False on a sink error or if fewer than count elements were pushed
+    bool finish() {
+        if (m_remaining != 0) {
+            return false;
+        }
+        pad(detail::image_align_up(m_offset, 4));
+        uint32_t checksum = m_checksum;
+        return write(&checksum, sizeof(checksum));
+    }
+
+    bool ok() const {
+        return m_ok;
+    }
+
+    // Bytes written so far
+    size_t size() const {
+        return m_offset;
+    }
+
+private:
+    bool write(const void* data, size_t size) {
+        m_ok = m_ok && m_sink(static_cast<const void*>(data), size);
+        m_checksum = detail::fnv1a(m_checksum, data, size);
+        m_offset += size;
+        return m_ok;
+    }
+
+    void pad(size_t offset) {
+        static const unsigned char zeros[16] = {};
+        while (m_offset < offset) {
+            size_t count = offset - m_offset;
+            write(zeros, (count < sizeof(zeros)) ? count : sizeof(zeros));
+        }
+    }
+
+    Sink& m_sink;
+    uint32_t m_checksum;
+    size_t m_offset;
+    size_t m_remaining;
+    bool m_ok;
+};
+
+// Images of whole containers; false on a sink error
+template <typename Sink, typename T, size_t Capacity, typename Storage, typename Overflow>
+bool write_image(Sink& sink, const vector<T, Capacity, Storage, Overflow>& source) {
+    image_writer<T, Sink> writer(sink, image_kind::vector, source.size());
+    for (const T& element : source) {
+        writer.push(element);
+    }
+    return writer.finish();
+}
+
+template <typename Sink, typename Key, typename T, typename Compare, size_t Capacity, typename Storage,
+          typename Overflow>
+bool write_image(Sink& sink, const map<Key, T, Compare, Capacity, Storage, Overflow>& source) {
+    using entry_type = map_image_entry<Key, T>;
+    image_writer<entry_type, Sink> writer(sink, image_kind::map, source.size());
+    for (const auto& element : source) {
+        // Zeroed first so the padding between the members is written as zeros
+        entry_type entry;
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(&entry.first, &element.first, sizeof(entry.first));
+        std::memcpy(&entry.second, &element.second, sizeof(entry.second));
+        writer.push(entry);
+    }
+    return writer.finish();
+}
+
+} // namespace estl
+
+#endif // ESTL_IMAGE_HPP
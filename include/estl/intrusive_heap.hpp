@@ -0,0 +1,257 @@
+#ifndef ESTL_INTRUSIVE_HEAP_HPP
+#define ESTL_INTRUSIVE_HEAP_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "algorithm.hpp"
+
+namespace estl {
+
+template <typename T, typename Compare, typename Tag>
+class intrusive_heap;
+
+/**
+ * @brief Link fields an element embeds to be stored in an intrusive_heap
+ *
+ * Derive the element type from intrusive_heap_hook<> (one per Tag to be in
+ * several heaps at once). Copying an element does not copy its membership.
+ *
+ * @tparam Tag Distinguishes several hooks in one element
+ */
+template <typename Tag = void>
+class intrusive_heap_hook {
+public:
+    constexpr intrusive_heap_hook() : m_child(nullptr), m_next(nullptr), m_prev(nullptr) {}
+
+    intrusive_heap_hook(const intrusive_heap_hook&) : m_child(nullptr), m_next(nullptr), m_prev(nullptr) {}
+
+    intrusive_heap_hook& operator=(const intrusive_heap_hook&) {
+        return *this;
+    }
+
+private:
+    intrusive_heap_hook* m_child; // First child
+    intrusive_heap_hook* m_next;  // Next sibling
+    intrusive_heap_hook* m_prev;  // Previous sibling, or the parent of a first child
+
+    template <typename, typename, typename>
+    friend class intrusive_heap;
+};
+
+/**
+ * @brief A priority queue of elements it does not own (pairing heap)
+ *
+ * The tree links live in the elements (see intrusive_heap_hook), so no
+ * element is ever copied or moved and nothing is allocated. Like
+ * std::priority_queue, top() is an element no other compares greater than;
+ * use greater<T> for earliest-deadline-first ordering.
+ *
+ * push, top, merge and promote are O(1); pop and erase are O(log N)
+ * amortized. Nothing is synchronized; a heap shared with an interrupt needs
+ * a critical section around updates.
+ *
+ * @tparam T The element type, derived from intrusive_heap_hook<Tag>
+ * @tparam Compare The comparison function object type
+ * @tparam Tag Selects the hook when T has several
+ */
+template <typename T, typename Compare = less<T>, typename Tag = void>
+class intrusive_heap {
+    using node_type = intrusive_heap_hook<Tag>;
+
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using value_compare = Compare;
+
+    // Constructors
+    constexpr intrusive_heap() : m_root(nullptr), m_size(0) {}
+
+    intrusive_heap(const intrusive_heap&) = delete;
+    intrusive_heap& operator=(const intrusive_heap&) = delete;
+
+    // Element access
+    reference top() {
+        ESTL_ASSERT(m_root != nullptr);
+        return element(m_root);
+    }
+
+    const_reference top() const {
+        ESTL_ASSERT(m_root != nullptr);
+        return element(m_root);
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_root == nullptr;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    // Modifiers
+    // value must not be in a heap through this hook
+    void push(reference value) {
+        node_type* node = static_cast<node_type*>(&value);
+        node->m_child = nullptr;
+        node->m_next = nullptr;
+        node->m_prev = nullptr;
+        m_root = m_root ? meld(m_root, node) : node;
+        ++m_size;
+    }
+
+    void pop() {
+        ESTL_ASSERT(m_root != nullptr);
+        m_root = merge_pairs(m_root->m_child);
+        --m_size;
+    }
+
+    // Removes an element held by this heap
+    void erase(reference value) {
+        node_type* node = static_cast<node_type*>(&value);
+        if (node == m_root) {
+            pop();
+            return;
+        }
+        cut(node);
+        node_type* rest = merge_pairs(node->m_child);
+        if (rest) {
+            m_root = meld(m_root, rest);
+        }
+        --m_size;
+    }
+
+    // Restores the order after value changed to compare greater than before
+    // (an earlier deadline with greater<T>); O(1)
+    void promote(reference value) {
+        node_type* node = static_cast<node_type*>(&value);
+        if (node != m_root) {
+            cut(node);
+            m_root = meld(m_root, node);
+        }
+    }
+
+    // Restores the order after any change to value
+    void update(reference value) {
+        erase(value);
+        push(value);
+    }
+
+    // Moves all elements of other into this heap, in O(1)
+    void merge(intrusive_heap& other) {
+        if (other.m_root) {
+            m_root = m_root ? meld(m_root, other.m_root) : other.m_root;
+            m_size += other.m_size;
+            other.m_root = nullptr;
+            other.m_size = 0;
+        }
+    }
+
+    // Forgets all elements; their hooks are reset when next pushed
+    void clear() {
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    void swap(intrusive_heap& other) {
+        node_type* root = m_root;
+        m_root = other.m_root;
+        other.m_root = root;
+        size_type size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+    }
+
+    // Observers
+    value_compare value_comp() const {
+        return Compare();
+    }
+
+private:
+    static T& element(node_type* node) {
+        return *static_cast<T*>(node);
+    }
+
+    static const T& element(const node_type* node) {
+        return *static_cast<const T*>(node);
+    }
+
+    // Links two roots; the lesser becomes the first child of the other
+    static node_type* meld(node_type* a, node_type* b) {
+        if (Compare()(element(a), element(b))) {
+            node_type* tmp = a;
+            a = b;
+            b = tmp;
+        }
+        b->m_next = a->m_child;
+        if (a->m_child) {
+            a->m_child->m_prev = b;
+        }
+        b->m_prev = a;
+        a->m_child = b;
+        return a;
+    }
+
+    // Detaches a non-root node (with its subtree) from its parent
+    static void cut(node_type* node) {
+        if (node->m_prev->m_child == node) {
+            node->m_prev->m_child = node->m_next;
+        }
+        else {
+            node->m_prev->m_next = node->m_next;
+        }
+        if (node->m_next) {
+            node->m_next->m_prev = node->m_prev;
+        }
+        node->m_next = nullptr;
+        node->m_prev = nullptr;
+    }
+
+    // Two-pass pairing of a sibling list into one tree: meld neighbours left
+    // to right, then fold the pairs right to left. Iterative, so the stack
+    // use does not grow with the heap.
+    static node_type* merge_pairs(node_type* first) {
+        node_type* pairs = nullptr;
+        while (first) {
+            node_type* a = first;
+            node_type* b = a->m_next;
+            first = b ? b->m_next : nullptr;
+            a->m_next = nullptr;
+            a->m_prev = nullptr;
+            if (b) {
+                b->m_next = nullptr;
+                b->m_prev = nullptr;
+                a = meld(a, b);
+            }
+            a->m_next = pairs;
+            pairs = a;
+        }
+
+        node_type* root = pairs;
+        if (root) {
+            pairs = root->m_next;
+            root->m_next = nullptr;
+            while (pairs) {
+                node_type* next = pairs->m_next;
+                pairs->m_next = nullptr;
+                root = meld(root, pairs);
+                pairs = next;
+            }
+        }
+        return root;
+    }
+
+    node_type* m_root;
+    size_type m_size;
+
+    static_assert(std::is_base_of<intrusive_heap_hook<Tag>, T>::value,
+                  "intrusive_heap elements must derive from intrusive_heap_hook<Tag>");
+};
+
+} // namespace estl
+
+#endif // ESTL_INTRUSIVE_HEAP_HPP
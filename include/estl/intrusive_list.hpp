@@ -0,0 +1,407 @@
+#ifndef ESTL_INTRUSIVE_LIST_HPP
+#define ESTL_INTRUSIVE_LIST_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "iterator.hpp"
+
+namespace estl {
+
+template <typename T, typename Tag>
+class intrusive_list;
+
+/**
+ * @brief Link fields an element embeds to be stored in an intrusive_list
+ *
+ * Derive the element type from intrusive_list_hook<> (or one hook per Tag to
+ * be on several lists at once). A linked element can remove itself with
+ * unlink() in O(1) without knowing which list holds it. Copying an element
+ * does not copy its list membership. Elements must be unlinked before they
+ * are destroyed.
+ *
+ * @tparam Tag Distinguishes several hooks in one element
+ */
+template <typename Tag = void>
+class intrusive_list_hook {
+public:
+    constexpr intrusive_list_hook() : m_next(nullptr), m_prev(nullptr) {}
+
+    intrusive_list_hook(const intrusive_list_hook&) : m_next(nullptr), m_prev(nullptr) {}
+
+    intrusive_list_hook& operator=(const intrusive_list_hook&) {
+        return *this;
+    }
+
+    bool is_linked() const {
+        return m_next != nullptr;
+    }
+
+    void unlink() {
+        if (m_next != nullptr) {
+            m_prev->m_next = m_next;
+            m_next->m_prev = m_prev;
+            m_next = nullptr;
+            m_prev = nullptr;
+        }
+    }
+
+private:
+    // List sentinel: an empty list points at itself
+    explicit constexpr intrusive_list_hook(intrusive_list_hook* self) : m_next(self), m_prev(self) {}
+
+    // Links this (unlinked) node in front of pos
+    void link_before(intrusive_list_hook* pos) {
+        m_next = pos;
+        m_prev = pos->m_prev;
+        pos->m_prev->m_next = this;
+        pos->m_prev = this;
+    }
+
+    intrusive_list_hook* m_next;
+    intrusive_list_hook* m_prev;
+
+    template <typename, typename>
+    friend class intrusive_list;
+};
+
+/**
+ * @brief A doubly linked list of elements it does not own
+ *
+ * The links live in the elements (see intrusive_list_hook), so insertion and
+ * removal are O(1), never copy or move an element and never allocate. A DMA
+ * descriptor or task control block can be queued where it already lives.
+ *
+ * The list does not keep a count, since elements may unlink themselves:
+ * size() walks the list. The list itself must not move while it holds
+ * elements, so it is neither copyable nor movable. Nothing is synchronized;
+ * a list shared with an interrupt needs a critical section around updates.
+ *
+ * @tparam T The element type, derived from intrusive_list_hook<Tag>
+ * @tparam Tag Selects the hook when T has several
+ */
+template <typename T, typename Tag = void>
+class intrusive_list {
+    using node_type = intrusive_list_hook<Tag>;
+
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    class iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() : m_node(nullptr) {}
+        explicit iterator(node_type* node) : m_node(node) {}
+
+        reference operator*() const {
+            return *static_cast<T*>(m_node);
+        }
+
+        pointer operator->() const {
+            return static_cast<T*>(m_node);
+        }
+
+        iterator& operator++() {
+            m_node = m_node->m_next;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        iterator& operator--() {
+            m_node = m_node->m_prev;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return m_node == other.m_node;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        node_type* m_node;
+
+        friend class intrusive_list;
+        friend class const_iterator;
+    };
+
+    class const_iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = const T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : m_node(nullptr) {}
+        explicit const_iterator(const node_type* node) : m_node(node) {}
+        const_iterator(const iterator& it) : m_node(it.m_node) {}
+
+        reference operator*() const {
+            return *static_cast<const T*>(m_node);
+        }
+
+        pointer operator->() const {
+            return static_cast<const T*>(m_node);
+        }
+
+        const_iterator& operator++() {
+            m_node = m_node->m_next;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator& operator--() {
+            m_node = m_node->m_prev;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_node == other.m_node;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const node_type* m_node;
+
+        friend class intrusive_list;
+    };
+
+    using reverse_iterator = estl::reverse_iterator<iterator>;
+    using const_reverse_iterator = estl::reverse_iterator<const_iterator>;
+
+    // Constructors
+    constexpr intrusive_list() : m_root(&m_root) {}
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    // Leaves the remaining elements unlinked
+    ~intrusive_list() {
+        clear();
+    }
+
+    // Element access
+    reference front() {
+        return *begin();
+    }
+
+    const_reference front() const {
+        return *begin();
+    }
+
+    reference back() {
+        return *iterator(m_root.m_prev);
+    }
+
+    const_reference back() const {
+        return *const_iterator(m_root.m_prev);
+    }
+
+    // Iterators
+    iterator begin() {
+        return iterator(m_root.m_next);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(m_root.m_next);
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    iterator end() {
+        return iterator(&m_root);
+    }
+
+    const_iterator end() const {
+        return const_iterator(&m_root);
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    // The position of an element known to be in this list, in O(1)
+    iterator iterator_to(reference value) {
+        return iterator(static_cast<node_type*>(&value));
+    }
+
+    const_iterator iterator_to(const_reference value) const {
+        return const_iterator(static_cast<const node_type*>(&value));
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_root.m_next == &m_root;
+    }
+
+    // O(N): the list keeps no count
+    size_type size() const {
+        size_type count = 0;
+        for (const node_type* node = m_root.m_next; node != &m_root; node = node->m_next) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Modifiers
+    void clear() {
+        node_type* node = m_root.m_next;
+        while (node != &m_root) {
+            node_type* next = node->m_next;
+            node->m_next = nullptr;
+            node->m_prev = nullptr;
+            node = next;
+        }
+        m_root.m_next = &m_root;
+        m_root.m_prev = &m_root;
+    }
+
+    // value must not be linked into a list through this hook
+    iterator insert(const_iterator pos, reference value) {
+        node_type* node = static_cast<node_type*>(&value);
+        ESTL_ASSERT(!node->is_linked());
+        node->link_before(mutable_node(pos));
+        return iterator(node);
+    }
+
+    void push_front(reference value) {
+        insert(begin(), value);
+    }
+
+    void push_back(reference value) {
+        insert(end(), value);
+    }
+
+    void pop_front() {
+        ESTL_ASSERT(!empty());
+        m_root.m_next->unlink();
+    }
+
+    void pop_back() {
+        ESTL_ASSERT(!empty());
+        m_root.m_prev->unlink();
+    }
+
+    iterator erase(const_iterator pos) {
+        node_type* node = mutable_node(pos);
+        iterator next(node->m_next);
+        node->unlink();
+        return next;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(mutable_node(last));
+    }
+
+    // Moves all elements of other in front of pos, in O(1)
+    void splice(const_iterator pos, intrusive_list& other) {
+        if (other.empty()) {
+            return;
+        }
+        node_type* target = mutable_node(pos);
+        node_type* first = other.m_root.m_next;
+        node_type* last = other.m_root.m_prev;
+
+        first->m_prev = target->m_prev;
+        target->m_prev->m_next = first;
+        last->m_next = target;
+        target->m_prev = last;
+
+        other.m_root.m_next = &other.m_root;
+        other.m_root.m_prev = &other.m_root;
+    }
+
+    // Moves the element at it (in other, or in this list) in front of pos
+    void splice(const_iterator pos, intrusive_list&, const_iterator it) {
+        node_type* node = mutable_node(it);
+        node_type* target = mutable_node(pos);
+        if (node == target || node->m_next == target) {
+            return;
+        }
+        node->unlink();
+        node->link_before(target);
+    }
+
+    void swap(intrusive_list& other) {
+        intrusive_list temp;
+        temp.splice(temp.end(), *this);
+        splice(end(), other);
+        other.splice(other.end(), temp);
+    }
+
+private:
+    // Iterators into a list the caller may modify
+    static node_type* mutable_node(const_iterator pos) {
+        return const_cast<node_type*>(pos.m_node);
+    }
+
+    node_type m_root;
+
+    static_assert(std::is_base_of<intrusive_list_hook<Tag>, T>::value,
+                  "intrusive_list elements must derive from intrusive_list_hook<Tag>");
+};
+
+} // namespace estl
+
+#endif // ESTL_INTRUSIVE_LIST_HPP
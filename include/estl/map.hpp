@@ -2,13 +2,26 @@
 #define ESTL_MAP_HPP
 
 #include <cstddef>
+#include <initializer_list>
+#include <tuple>
 #include <utility>
 #include "config.hpp"
 #include "iterator.hpp"
 #include "algorithm.hpp"
+#include "memory.hpp"
+#include "overflow.hpp"
+#include "stats.hpp"
 
 namespace estl {
 
+/**
+ * @brief Tag selecting the constructors that take input already sorted by
+ * key and free of duplicates
+ */
+struct sorted_unique_t {};
+
+constexpr sorted_unique_t sorted_unique = sorted_unique_t();
+
 /**
  * @brief A sorted associative container for embedded systems
  * 
@@ -20,14 +33,31 @@ namespace estl {
  * @tparam T The type of mapped values
  * @tparam Compare The comparison function object type
  * @tparam Capacity The maximum number of elements (static allocation)
+ * @tparam Storage Where the elements live (static_storage or allocator_storage)
+ * @tparam Overflow What insertions into a full map do (see overflow_assert)
  */
 template <
     typename Key,
     typename T,
     typename Compare = less<Key>,
-    size_t Capacity = 16
+    size_t Capacity = 16,
+    typename Storage = static_storage,
+    typename Overflow = overflow_assert
 >
-class map {
+class map : private Storage::template buffer<std::pair<const Key, T>, Capacity>, private detail::stats_base {
+    using storage_base = typename Storage::template buffer<std::pair<const Key, T>, Capacity>;
+    using stats_base = detail::stats_base;
+    using storage_base::elements;
+    using storage_base::acquire_storage;
+    using storage_base::release_storage;
+    using storage_base::swap_storage;
+    using storage_base::m_size;
+    using stats_base::record_size;
+    using stats_base::record_insert;
+    using stats_base::record_erase;
+    using stats_base::record_find;
+    using stats_base::record_overflow;
+
 public:
     // Type definitions
     using key_type = Key;
@@ -54,11 +84,11 @@ public:
         iterator(map* map_ptr, size_type index) : m_ptr(map_ptr), m_index(index) {}
 
         reference operator*() const {
-            return m_ptr->m_data[m_index];
+            return m_ptr->elements()[m_index];
         }
 
         pointer operator->() const {
-            return &(m_ptr->m_data[m_index]);
+            return &(m_ptr->elements()[m_index]);
         }
 
         iterator& operator++() {
@@ -94,6 +124,9 @@ public:
     private:
         map* m_ptr;
         size_type m_index;
+
+        friend class map;
+        friend class const_iterator;
     };
 
     class const_iterator {
@@ -109,11 +142,11 @@ public:
         const_iterator(const iterator& it) : m_ptr(it.m_ptr), m_index(it.m_index) {}
 
         reference operator*() const {
-            return m_ptr->m_data[m_index];
+            return m_ptr->elements()[m_index];
         }
 
         pointer operator->() const {
-            return &(m_ptr->m_data[m_index]);
+            return &(m_ptr->elements()[m_index]);
         }
 
         const_iterator& operator++() {
@@ -149,6 +182,8 @@ public:
     private:
         const map* m_ptr;
         size_type m_index;
+
+        friend class map;
     };
 
     using reverse_iterator = estl::reverse_iterator<iterator>;
@@ -167,21 +202,54 @@ public:
     };
 
     // Constructors
-    map() : m_size(0) {}
+    constexpr map() : storage_base(), stats_base(this, "map", Capacity) {}
+
+    map(const map& other) : storage_base(), stats_base(this, "map", Capacity) {
+        copy_elements(other);
+    }
+
+    template <typename InputIt>
+    map(InputIt first, InputIt last) : storage_base(), stats_base(this, "map", Capacity) {
+        insert(first, last);
+    }
+
+    map(std::initializer_list<value_type> init) : storage_base(), stats_base(this, "map", Capacity) {
+        insert(init.begin(), init.end());
+    }
 
-    map(const map& other) : m_size(0) {
-        for (size_type i = 0; i < other.m_size; ++i) {
-            insert(other.m_data[i]);
+    // The input is trusted to be sorted (checked by ESTL_ASSERT only), so
+    // elements are appended without any search: O(N). An equivalent key is
+    // only compared with its predecessor and, as in insert, the first kept.
+    template <typename InputIt>
+    map(sorted_unique_t, InputIt first, InputIt last) : storage_base(), stats_base(this, "map", Capacity) {
+        if (first != last && acquire_storage()) {
+            for (; first != last && m_size < Capacity; ++first) {
+                value_type* added = &elements()[m_size];
+                new (added) value_type(*first);
+                if (m_size > 0 && !key_comp()(added[-1].first, added->first)) {
+                    ESTL_ASSERT(!key_comp()(added->first, added[-1].first));
+                    added->~value_type();
+                    continue;
+                }
+                ++m_size;
+            }
+            record_size(m_size);
+        }
+        // Leftovers, or all of them without a storage block, meet the
+        // overflow policy one by one
+        for (; first != last; ++first) {
+            insert(*first);
         }
     }
 
+    map(sorted_unique_t, std::initializer_list<value_type> init)
+        : map(sorted_unique, init.begin(), init.end()) {}
+
     // Assignment operator
     map& operator=(const map& other) {
         if (this != &other) {
             clear();
-            for (size_type i = 0; i < other.m_size; ++i) {
-                insert(other.m_data[i]);
-            }
+            copy_elements(other);
         }
         return *this;
     }
@@ -205,14 +273,15 @@ public:
         return it->second;
     }
 
+    // One search; a new element is value-initialized in its final slot.
+    // A new key needs room (or an evicting Overflow policy), asserted like
+    // the key of at(); try_emplace reports a rejected one instead.
     T& operator[](const Key& key) {
-        iterator it = find(key);
-        if (it != end()) {
-            return it->second;
-        }
-        
-        // Insert new element with default value
-        return insert(std::make_pair(key, T())).first->second;
+        return mapped_or_assert(try_emplace(key).first);
+    }
+
+    T& operator[](Key&& key) {
+        return mapped_or_assert(try_emplace(std::move(key)).first);
     }
 
     // Iterators
@@ -279,61 +348,162 @@ public:
 
     // Modifiers
     void clear() {
-        for (size_type i = 0; i < m_size; ++i) {
-            m_data[i].~value_type();
-        }
+        destroy(elements(), elements() + m_size);
         m_size = 0;
+        release_storage();
     }
 
     std::pair<iterator, bool> insert(const value_type& value) {
-        // Check if key already exists
-        iterator it = find(value.first);
-        if (it != end()) {
-            return std::make_pair(it, false);
-        }
-        
-        // Check if we have capacity
-        if (m_size >= Capacity) {
-            // Handle capacity exceeded
-            ESTL_ASSERT(m_size < Capacity);
-            return std::make_pair(end(), false);
+        return insert_unique(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_unique(std::move(value));
+    }
+
+    // No search when hint is the insert position, so inserting ascending
+    // keys at end() costs O(1) each
+    iterator insert(const_iterator hint, const value_type& value) {
+        return insert_hinted(hint, value);
+    }
+
+    iterator insert(const_iterator hint, value_type&& value) {
+        return insert_hinted(hint, std::move(value));
+    }
+
+    /**
+     * @brief Constructs an element from args if its key is not present
+     *
+     * The element is built directly in the first free slot, where it stays
+     * when its key is the largest; otherwise it is moved once into place.
+     * Prefer try_emplace when the key is at hand: it searches before
+     * constructing anything.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        if (m_size == Capacity || !acquire_storage()) {
+            // No spare slot to build in; the key can only be found, not added
+            return insert_unique(value_type(std::forward<Args>(args)...));
         }
-        
-        // Find position to insert (keep sorted)
-        size_type pos = m_size;
-        for (size_type i = 0; i < m_size; ++i) {
-            if (key_comp()(value.first, m_data[i].first)) {
-                pos = i;
-                break;
-            }
+
+        value_type* spare = elements() + m_size;
+        new (spare) value_type(std::forward<Args>(args)...);
+        size_type pos = lower_index(spare->first);
+        if (pos < m_size && !key_comp()(spare->first, elements()[pos].first)) {
+            spare->~value_type();
+            return std::make_pair(iterator(this, pos), false);
         }
-        
-        // Shift elements to make space
-        for (size_type i = m_size; i > pos; --i) {
-            new (&m_data[i]) value_type(std::move(m_data[i-1]));
-            m_data[i-1].~value_type();
+        if (pos == m_size) {
+            ++m_size;
+            record_insert(m_size, 0);
+        } else {
+            value_type value(std::move(*spare));
+            spare->~value_type();
+            construct_at(pos, std::move(value));
         }
-        
-        // Insert new element
-        new (&m_data[pos]) value_type(value);
-        ++m_size;
-        
         return std::make_pair(iterator(this, pos), true);
     }
 
+    // Searches once and, only if key is absent, constructs the mapped value
+    // from args directly in its final slot
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return try_emplace_key(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        return try_emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator hint, const Key& key, Args&&... args) {
+        return try_emplace_hinted(hint, key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator hint, Key&& key, Args&&... args) {
+        return try_emplace_hinted(hint, std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Assigns obj to the mapped value of key, inserting it if absent
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        return insert_or_assign_key(key, std::forward<M>(obj));
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        return insert_or_assign_key(std::move(key), std::forward<M>(obj));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        // The key is only known once the element has been built
+        value_type value(std::forward<Args>(args)...);
+        size_type pos;
+        if (locate(hint, value.first, pos)) {
+            return iterator(this, pos);
+        }
+        if (!emplace_at(pos, std::move(value))) {
+            return end();
+        }
+        return iterator(this, pos);
+    }
+
+    /**
+     * @brief Inserts the elements of [first, last) in O((N + M) log N)
+     *
+     * New elements are staged in free slots at the top of the storage,
+     * sorted with estl::stable_sort, stripped of duplicates and of keys
+     * already present, then merged with the existing elements in one
+     * backward pass. An empty map stages up to three quarters of its slots
+     * per batch, leaving the rest as the sort's merge buffer; a non-empty
+     * one stages at most half of its free slots so the merge never
+     * overwrites a staged element. Once no slot can be spared the remainder
+     * is inserted one by one. As for std::map, of several equivalent keys in
+     * the range only the first is inserted, and a key already present keeps
+     * its element.
+     */
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        while (first != last) {
+            size_type free_slots = Capacity - m_size;
+            size_type batch = (m_size == 0) ? free_slots - free_slots / 4 : free_slots / 2;
+            // Without room (or a storage block) the rest meet the overflow
+            // policy one by one
+            if (batch == 0 || !acquire_storage()) {
+                for (; first != last; ++first) {
+                    insert(*first);
+                }
+                return;
+            }
+
+            // An empty map stages in place; otherwise stage above the merge target
+            staged_type* staging = staged_elements() + ((m_size == 0) ? 0 : Capacity - batch);
+            size_type count = 0;
+            for (; first != last && count < batch; ++first, ++count) {
+                new (&staging[count]) staged_type(*first);
+            }
+            merge_staged(staging, count);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> init) {
+        insert(init.begin(), init.end());
+    }
+
     iterator erase(const_iterator pos) {
         size_type index = pos.m_index;
         
         // Destroy element
-        m_data[index].~value_type();
+        elements()[index].~value_type();
         
         // Shift elements
-        for (size_type i = index; i < m_size - 1; ++i) {
-            new (&m_data[i]) value_type(std::move(m_data[i+1]));
-            m_data[i+1].~value_type();
-        }
+        detail::relocate_down(elements(), index, m_size);
         
         --m_size;
+        record_erase(m_size - index);
         return iterator(this, index);
     }
 
@@ -348,29 +518,39 @@ public:
     }
 
     void swap(map& other) {
-        // Since we can't swap the arrays directly (fixed size),
-        // we need to swap elements individually
+        // Allocator blocks change hands, so swapping never allocates
+        if (swap_storage(other)) {
+            record_size(m_size);
+            other.record_size(other.m_size);
+            return;
+        }
+
+        // Inline arrays can't be swapped directly (fixed size),
+        // we need to swap elements individually. Keys are const, so
+        // elements are exchanged by reconstruction rather than assignment.
         size_type min_size = (m_size < other.m_size) ? m_size : other.m_size;
         
         // Swap common elements
         for (size_type i = 0; i < min_size; ++i) {
-            value_type temp = std::move(m_data[i]);
-            m_data[i] = std::move(other.m_data[i]);
-            other.m_data[i] = std::move(temp);
+            value_type temp(std::move(elements()[i]));
+            elements()[i].~value_type();
+            new (&elements()[i]) value_type(std::move(other.elements()[i]));
+            other.elements()[i].~value_type();
+            new (&other.elements()[i]) value_type(std::move(temp));
         }
         
         // Handle case where this map is larger
         if (m_size > min_size) {
             for (size_type i = min_size; i < m_size; ++i) {
-                new (&other.m_data[i]) value_type(std::move(m_data[i]));
-                m_data[i].~value_type();
+                new (&other.elements()[i]) value_type(std::move(elements()[i]));
+                elements()[i].~value_type();
             }
         }
         // Handle case where other map is larger
         else if (other.m_size > min_size) {
             for (size_type i = min_size; i < other.m_size; ++i) {
-                new (&m_data[i]) value_type(std::move(other.m_data[i]));
-                other.m_data[i].~value_type();
+                new (&elements()[i]) value_type(std::move(other.elements()[i]));
+                other.elements()[i].~value_type();
             }
         }
         
@@ -378,6 +558,8 @@ public:
         size_type temp_size = m_size;
         m_size = other.m_size;
         other.m_size = temp_size;
+        record_size(m_size);
+        other.record_size(other.m_size);
     }
 
     // Lookup
@@ -386,19 +568,19 @@ public:
     }
 
     iterator find(const Key& key) {
-        for (size_type i = 0; i < m_size; ++i) {
-            if (!key_comp()(m_data[i].first, key) && !key_comp()(key, m_data[i].first)) {
-                return iterator(this, i);
-            }
+        record_find();
+        size_type index = lower_index(key);
+        if (index < m_size && !key_comp()(key, elements()[index].first)) {
+            return iterator(this, index);
         }
         return end();
     }
 
     const_iterator find(const Key& key) const {
-        for (size_type i = 0; i < m_size; ++i) {
-            if (!key_comp()(m_data[i].first, key) && !key_comp()(key, m_data[i].first)) {
-                return const_iterator(this, i);
-            }
+        record_find();
+        size_type index = lower_index(key);
+        if (index < m_size && !key_comp()(key, elements()[index].first)) {
+            return const_iterator(this, index);
         }
         return end();
     }
@@ -416,39 +598,19 @@ public:
     }
 
     iterator lower_bound(const Key& key) {
-        for (size_type i = 0; i < m_size; ++i) {
-            if (!key_comp()(m_data[i].first, key)) {
-                return iterator(this, i);
-            }
-        }
-        return end();
+        return iterator(this, lower_index(key));
     }
 
     const_iterator lower_bound(const Key& key) const {
-        for (size_type i = 0; i < m_size; ++i) {
-            if (!key_comp()(m_data[i].first, key)) {
-                return const_iterator(this, i);
-            }
-        }
-        return end();
+        return const_iterator(this, lower_index(key));
     }
 
     iterator upper_bound(const Key& key) {
-        for (size_type i = 0; i < m_size; ++i) {
-            if (key_comp()(key, m_data[i].first)) {
-                return iterator(this, i);
-            }
-        }
-        return end();
+        return iterator(this, upper_index(key));
     }
 
     const_iterator upper_bound(const Key& key) const {
-        for (size_type i = 0; i < m_size; ++i) {
-            if (key_comp()(key, m_data[i].first)) {
-                return const_iterator(this, i);
-            }
-        }
-        return end();
+        return const_iterator(this, upper_index(key));
     }
 
     // Observers
@@ -461,10 +623,252 @@ public:
     }
 
 private:
-    // Storage for elements - using aligned storage to allow for proper construction/destruction
-    alignas(value_type) unsigned char m_storage[sizeof(value_type) * Capacity];
-    value_type* m_data = reinterpret_cast<value_type*>(m_storage);
-    size_type m_size;
+    T& mapped_or_assert(iterator it) {
+        ESTL_ASSERT(it != end() && "operator[] on a full map");
+        return it->second;
+    }
+
+    // Heterogeneous comparator so estl::lower_bound/upper_bound can search
+    // the sorted storage directly by key
+    struct key_value_compare {
+        bool operator()(const value_type& lhs, const Key& rhs) const {
+            return Compare()(lhs.first, rhs);
+        }
+
+        bool operator()(const Key& lhs, const value_type& rhs) const {
+            return Compare()(lhs, rhs.first);
+        }
+    };
+
+    // Index of the first element whose key is not less than key (O(log N))
+    size_type lower_index(const Key& key) const {
+        return static_cast<size_type>(
+            estl::lower_bound(elements(), elements() + m_size, key, key_value_compare()) - elements());
+    }
+
+    // Index of the first element whose key is greater than key (O(log N))
+    size_type upper_index(const Key& key) const {
+        return static_cast<size_type>(
+            estl::upper_bound(elements(), elements() + m_size, key, key_value_compare()) - elements());
+    }
+
+    // Constructs a new element at pos, the slot for its key, if there is
+    // room, or as the overflow policy prescribes; pos is updated to where
+    // it went. Returns false when the element was dropped.
+    template <typename... Args>
+    bool emplace_at(size_type& pos, Args&&... args) {
+        if (m_size < Capacity && acquire_storage()) {
+            construct_at(pos, std::forward<Args>(args)...);
+            return true;
+        }
+        record_overflow();
+        Overflow::on_overflow();
+        return emplace_evicting(pos, detail::overflow_tag<Overflow>(), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    bool emplace_evicting(size_type&, std::integral_constant<overflow_action, overflow_action::reject>, Args&&...) {
+        return false;
+    }
+
+    // The value is built first, the arguments may refer to the element
+    // about to be evicted
+    template <typename Action, typename... Args>
+    bool emplace_evicting(size_type& pos, Action action, Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+        size_type shifted = 0;
+        if (!detail::open_overflow_slot(elements(), m_size, pos, shifted, action)) {
+            return false;
+        }
+        new (&elements()[pos]) value_type(std::move(value));
+        record_erase(shifted);
+        record_insert(m_size, 0);
+        return true;
+    }
+
+    // Opens a gap at pos and constructs the new element in it
+    template <typename... Args>
+    void construct_at(size_type pos, Args&&... args) {
+        detail::relocate_up(elements(), pos, m_size);
+        new (&elements()[pos]) value_type(std::forward<Args>(args)...);
+        ++m_size;
+        record_insert(m_size, m_size - 1 - pos);
+    }
+
+    // Single search gives both the duplicate check and the insert position
+    template <typename V>
+    std::pair<iterator, bool> insert_unique(V&& value) {
+        size_type pos = lower_index(value.first);
+        if (pos < m_size && !key_comp()(value.first, elements()[pos].first)) {
+            return std::make_pair(iterator(this, pos), false);
+        }
+        if (!emplace_at(pos, std::forward<V>(value))) {
+            return std::make_pair(end(), false);
+        }
+        return std::make_pair(iterator(this, pos), true);
+    }
+
+    template <typename V>
+    iterator insert_hinted(const_iterator hint, V&& value) {
+        size_type pos;
+        if (locate(hint, value.first, pos)) {
+            return iterator(this, pos);
+        }
+        if (!emplace_at(pos, std::forward<V>(value))) {
+            return end();
+        }
+        return iterator(this, pos);
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace_key(K&& key, Args&&... args) {
+        size_type pos = lower_index(key);
+        if (pos < m_size && !key_comp()(key, elements()[pos].first)) {
+            return std::make_pair(iterator(this, pos), false);
+        }
+        if (!emplace_at(pos, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...))) {
+            return std::make_pair(end(), false);
+        }
+        return std::make_pair(iterator(this, pos), true);
+    }
+
+    template <typename K, typename... Args>
+    iterator try_emplace_hinted(const_iterator hint, K&& key, Args&&... args) {
+        size_type pos;
+        if (locate(hint, key, pos)) {
+            return iterator(this, pos);
+        }
+        if (!emplace_at(pos, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...))) {
+            return end();
+        }
+        return iterator(this, pos);
+    }
+
+    template <typename K, typename M>
+    std::pair<iterator, bool> insert_or_assign_key(K&& key, M&& obj) {
+        size_type pos = lower_index(key);
+        if (pos < m_size && !key_comp()(key, elements()[pos].first)) {
+            elements()[pos].second = std::forward<M>(obj);
+            return std::make_pair(iterator(this, pos), false);
+        }
+        if (!emplace_at(pos, std::forward<K>(key), std::forward<M>(obj))) {
+            return std::make_pair(end(), false);
+        }
+        return std::make_pair(iterator(this, pos), true);
+    }
+
+    // Sets pos to the slot for key, trying hint before searching. Returns
+    // true when key is already present at pos.
+    bool locate(const_iterator hint, const Key& key, size_type& pos) const {
+        size_type index = hint.m_index;
+        if ((index == m_size || key_comp()(key, elements()[index].first)) &&
+            (index == 0 || key_comp()(elements()[index - 1].first, key))) {
+            pos = index;
+            return false;
+        }
+        pos = lower_index(key);
+        return pos < m_size && !key_comp()(key, elements()[pos].first);
+    }
+
+    // Range inserts stage elements with a mutable key so estl::sort can
+    // assign them; both pair types share one layout.
+    using staged_type = std::pair<Key, T>;
+
+    static_assert(sizeof(staged_type) == sizeof(value_type) && alignof(staged_type) == alignof(value_type),
+                  "map staging requires pair<Key, T> and pair<const Key, T> to share a layout");
+
+    struct staged_compare {
+        bool operator()(const staged_type& lhs, const staged_type& rhs) const {
+            return Compare()(lhs.first, rhs.first);
+        }
+    };
+
+    staged_type* staged_elements() {
+        return reinterpret_cast<staged_type*>(elements());
+    }
+
+    // Sorts and dedups count staged elements, then merges them into the map
+    void merge_staged(staged_type* staging, size_type count) {
+        // Stable, so the first of equivalent keys stays first. Free slots
+        // beside the staged elements become the merge buffer of up to half
+        // their number: constructed by moving a staged element out and back,
+        // they hold moved-from values the sort can assign to.
+        staged_type* spare = staged_elements() + ((m_size == 0) ? count : m_size);
+        size_type room = (m_size == 0) ? Capacity - count : count / 2;
+        size_type spare_count = (count / 2 < room) ? count / 2 : room;
+        for (size_type i = 0; i < spare_count; ++i) {
+            new (&spare[i]) staged_type(std::move(staging[i]));
+            staging[i] = std::move(spare[i]);
+        }
+        estl::stable_sort(staging, staging + count, spare, spare_count, staged_compare());
+        destroy(spare, spare + spare_count);
+
+        size_type unique = 0;
+        for (size_type i = 0; i < count; ++i) {
+            const Key& key = staging[i].first;
+            size_type existing = lower_index(key);
+            bool duplicate = (unique > 0 && !key_comp()(staging[unique - 1].first, key)) ||
+                             (existing < m_size && !key_comp()(key, elements()[existing].first));
+            if (!duplicate) {
+                if (unique != i) {
+                    staging[unique] = std::move(staging[i]);
+                }
+                ++unique;
+            }
+        }
+        destroy(staging + unique, staging + count);
+
+        // Merge from the back: each element moves at most once
+        value_type* data = elements();
+        size_type write = m_size + unique;
+        size_type remaining = m_size;
+        size_type shifted = 0;
+        while (unique > 0) {
+            --write;
+            if (remaining > 0 && key_comp()(staging[unique - 1].first, data[remaining - 1].first)) {
+                --remaining;
+                new (&data[write]) value_type(std::move(data[remaining]));
+                data[remaining].~value_type();
+                ++shifted;
+            } else {
+                --unique;
+                settle(staging[unique], data + write);
+                ++m_size;
+                record_insert(m_size, shifted);
+                shifted = 0;
+            }
+        }
+    }
+
+    // Turns a staged element into a value_type at target; the two coincide
+    // when an empty map staged in place
+    void settle(staged_type& source, value_type* target) {
+        if (static_cast<void*>(&source) == static_cast<void*>(target)) {
+            staged_type temp(std::move(source));
+            source.~staged_type();
+            new (target) value_type(std::move(temp.first), std::move(temp.second));
+        } else {
+            new (target) value_type(std::move(source.first), std::move(source.second));
+            source.~staged_type();
+        }
+    }
+
+    // The source is already sorted and unique, so it is copied as a block
+    void copy_elements(const map& other) {
+        if (other.m_size == 0) {
+            return;
+        }
+        if (!acquire_storage()) {
+            record_overflow();
+            Overflow::on_overflow();
+            return;
+        }
+        uninitialized_copy(other.elements(), other.elements() + other.m_size, elements());
+        m_size = other.m_size;
+        record_size(m_size);
+    }
 
     // Make iterators friends to access private members
     friend class iterator;
@@ -472,8 +876,8 @@ private:
 };
 
 // Non-member functions
-template <typename Key, typename T, typename Compare, size_t Capacity>
-bool operator==(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Compare, Capacity>& rhs) {
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+bool operator==(const map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, const map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
@@ -492,33 +896,33 @@ bool operator==(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Com
     return true;
 }
 
-template <typename Key, typename T, typename Compare, size_t Capacity>
-bool operator!=(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Compare, Capacity>& rhs) {
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+bool operator!=(const map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, const map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Key, typename T, typename Compare, size_t Capacity>
-bool operator<(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Compare, Capacity>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+bool operator<(const map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, const map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
+    return estl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Key, typename T, typename Compare, size_t Capacity>
-bool operator<=(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Compare, Capacity>& rhs) {
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+bool operator<=(const map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, const map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
     return !(rhs < lhs);
 }
 
-template <typename Key, typename T, typename Compare, size_t Capacity>
-bool operator>(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Compare, Capacity>& rhs) {
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+bool operator>(const map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, const map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
     return rhs < lhs;
 }
 
-template <typename Key, typename T, typename Compare, size_t Capacity>
-bool operator>=(const map<Key, T, Compare, Capacity>& lhs, const map<Key, T, Compare, Capacity>& rhs) {
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+bool operator>=(const map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, const map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
     return !(lhs < rhs);
 }
 
-template <typename Key, typename T, typename Compare, size_t Capacity>
-void swap(map<Key, T, Compare, Capacity>& lhs, map<Key, T, Compare, Capacity>& rhs) {
+template <typename Key, typename T, typename Compare, size_t Capacity, typename Storage, typename Overflow>
+void swap(map<Key, T, Compare, Capacity, Storage, Overflow>& lhs, map<Key, T, Compare, Capacity, Storage, Overflow>& rhs) {
     lhs.swap(rhs);
 }
 
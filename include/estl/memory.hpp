@@ -0,0 +1,456 @@
+#ifndef ESTL_MEMORY_HPP
+#define ESTL_MEMORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "iterator.hpp"
+
+namespace estl {
+
+/**
+ * @brief Whether objects of type T can be moved to new storage with memcpy
+ *
+ * True for trivially copyable types. std::pair is handled separately because
+ * its assignment operators make it non-trivially copyable even when both
+ * members are, yet relocating it bytewise is still safe.
+ */
+template <typename T>
+struct is_trivially_relocatable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+template <typename T>
+struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> {};
+
+template <typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2> >
+    : std::integral_constant<bool,
+        is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
+namespace detail {
+
+// True when [first, last) -> d_first is a pointer range over the same
+// trivially relocatable type, i.e. it can be copied with one memcpy/memmove
+template <typename InputIt, typename T>
+struct is_bitwise_constructible_range : std::false_type {};
+
+template <typename U, typename T>
+struct is_bitwise_constructible_range<U*, T>
+    : std::integral_constant<bool,
+        std::is_same<typename std::remove_const<U>::type, T>::value &&
+        is_trivially_relocatable<T>::value> {};
+
+} // namespace detail
+
+// Destruction
+template <typename T>
+void destroy(T* first, T* last) {
+    if (!std::is_trivially_destructible<T>::value) {
+        for (; first != last; ++first) {
+            first->~T();
+        }
+    }
+}
+
+// Uninitialized copy - constructs copies of [first, last) in raw storage
+template <typename InputIt, typename T>
+T* uninitialized_copy_impl(InputIt first, InputIt last, T* d_first, std::false_type) {
+    for (; first != last; ++first, ++d_first) {
+        new (d_first) T(*first);
+    }
+    return d_first;
+}
+
+template <typename InputIt, typename T>
+T* uninitialized_copy_impl(InputIt first, InputIt last, T* d_first, std::true_type) {
+    size_t count = static_cast<size_t>(last - first);
+    if (count > 0) {
+        std::memcpy(static_cast<void*>(d_first), static_cast<const void*>(first), count * sizeof(T));
+    }
+    return d_first + count;
+}
+
+template <typename InputIt, typename T>
+T* uninitialized_copy(InputIt first, InputIt last, T* d_first) {
+    return uninitialized_copy_impl(first, last, d_first,
+        detail::is_bitwise_constructible_range<InputIt, T>());
+}
+
+// Uninitialized move - move-constructs [first, last) into raw storage
+template <typename T>
+T* uninitialized_move_impl(T* first, T* last, T* d_first, std::false_type) {
+    for (; first != last; ++first, ++d_first) {
+        new (d_first) T(std::move(*first));
+    }
+    return d_first;
+}
+
+template <typename T>
+T* uninitialized_move_impl(T* first, T* last, T* d_first, std::true_type) {
+    return uninitialized_copy_impl(first, last, d_first, std::true_type());
+}
+
+template <typename T>
+T* uninitialized_move(T* first, T* last, T* d_first) {
+    return uninitialized_move_impl(first, last, d_first, is_trivially_relocatable<T>());
+}
+
+// Uninitialized fill - constructs count copies of value in raw storage
+template <typename T>
+T* uninitialized_fill_n_impl(T* first, size_t count, const T& value, std::false_type) {
+    for (size_t i = 0; i < count; ++i, ++first) {
+        new (first) T(value);
+    }
+    return first;
+}
+
+template <typename T>
+T* uninitialized_fill_n_impl(T* first, size_t count, const T& value, std::true_type) {
+    if (count > 0) {
+        unsigned char byte;
+        std::memcpy(&byte, &value, 1);
+        std::memset(static_cast<void*>(first), byte, count);
+    }
+    return first + count;
+}
+
+template <typename T>
+T* uninitialized_fill_n(T* first, size_t count, const T& value) {
+    return uninitialized_fill_n_impl(first, count, value,
+        std::integral_constant<bool, sizeof(T) == 1 && std::is_trivially_copyable<T>::value>());
+}
+
+namespace detail {
+
+// Relocation helpers used by the contiguous containers to open and close
+// gaps. Trivially relocatable types collapse into a single memmove.
+
+// Moves the live elements [index, size) up by one slot; data[size] must be
+// raw storage. Leaves data[index] as raw storage.
+template <typename T>
+void relocate_up(T* data, size_t index, size_t size, std::true_type) {
+    if (size > index) {
+        std::memmove(static_cast<void*>(data + index + 1), static_cast<const void*>(data + index),
+                     (size - index) * sizeof(T));
+    }
+}
+
+template <typename T>
+void relocate_up(T* data, size_t index, size_t size, std::false_type) {
+    for (size_t i = size; i > index; --i) {
+        new (&data[i]) T(std::move(data[i - 1]));
+        data[i - 1].~T();
+    }
+}
+
+template <typename T>
+void relocate_up(T* data, size_t index, size_t size) {
+    relocate_up(data, index, size, is_trivially_relocatable<T>());
+}
+
+// Moves the live elements [index + 1, size) down by one slot; data[index]
+// must already be destroyed. Leaves data[size - 1] as raw storage.
+template <typename T>
+void relocate_down(T* data, size_t index, size_t size, std::true_type) {
+    if (size > index + 1) {
+        std::memmove(static_cast<void*>(data + index), static_cast<const void*>(data + index + 1),
+                     (size - index - 1) * sizeof(T));
+    }
+}
+
+template <typename T>
+void relocate_down(T* data, size_t index, size_t size, std::false_type) {
+    for (size_t i = index; i + 1 < size; ++i) {
+        new (&data[i]) T(std::move(data[i + 1]));
+        data[i + 1].~T();
+    }
+}
+
+template <typename T>
+void relocate_down(T* data, size_t index, size_t size) {
+    relocate_down(data, index, size, is_trivially_relocatable<T>());
+}
+
+// Smallest unsigned type able to count up to Capacity
+template <size_t Capacity>
+struct capacity_size_type {
+    using type = typename std::conditional<(Capacity <= 0xFFu), uint8_t,
+                 typename std::conditional<(Capacity <= 0xFFFFu), uint16_t,
+                 typename std::conditional<(Capacity <= 0xFFFFFFFFu), uint32_t,
+                 size_t>::type>::type>::type;
+};
+
+// Raw inline storage for Capacity objects of type T. The union lets the
+// constructor be constexpr without touching the element bytes, so empty
+// static containers are constant-initialized into .bss.
+template <typename T, size_t Capacity>
+union inline_storage {
+    constexpr inline_storage() : m_empty() {}
+
+    unsigned char m_empty;
+    alignas(T) unsigned char m_bytes[sizeof(T) * Capacity];
+};
+
+// Element storage plus live-element count shared by the inline containers.
+// The element pointer is derived from the storage on every access rather
+// than cached, so containers stay pointer-free and bytewise relocatable.
+template <typename T, size_t Capacity>
+struct inline_buffer_base {
+    constexpr inline_buffer_base() : m_storage(), m_size(0) {}
+
+    T* elements() {
+        return reinterpret_cast<T*>(m_storage.m_bytes);
+    }
+
+    const T* elements() const {
+        return reinterpret_cast<const T*>(m_storage.m_bytes);
+    }
+
+    // Inline storage always exists
+    bool acquire_storage(size_t = Capacity) {
+        return true;
+    }
+
+    void release_storage() {}
+
+    // Whether acquire_storage(count) leaves the live elements in place
+    bool keeps_elements(size_t) const {
+        return true;
+    }
+
+    // There is no block to hand over; the elements are exchanged one by one
+    bool swap_storage(inline_buffer_base&) {
+        return false;
+    }
+
+    inline_storage<T, Capacity> m_storage;
+    typename capacity_size_type<Capacity>::type m_size;
+};
+
+// Only element types that need it get a destructor, so containers of
+// trivially destructible types stay trivially destructible
+template <typename T, size_t Capacity, bool = std::is_trivially_destructible<T>::value>
+struct inline_buffer : inline_buffer_base<T, Capacity> {
+    constexpr inline_buffer() : inline_buffer_base<T, Capacity>() {}
+};
+
+template <typename T, size_t Capacity>
+struct inline_buffer<T, Capacity, false> : inline_buffer_base<T, Capacity> {
+    constexpr inline_buffer() : inline_buffer_base<T, Capacity>() {}
+
+    ~inline_buffer() {
+        destroy(this->elements(), this->elements() + this->m_size);
+    }
+};
+
+// Element storage obtained from Allocator on first use. The block always
+// holds Capacity elements, so it is never reallocated while in use.
+template <typename T, size_t Capacity, typename Allocator>
+struct allocator_buffer {
+    static_assert(alignof(T) <= Allocator::alignment,
+                  "allocator does not provide the alignment T requires");
+
+    constexpr allocator_buffer() : m_data(nullptr), m_size(0) {}
+
+    allocator_buffer(const allocator_buffer&) = delete;
+    allocator_buffer& operator=(const allocator_buffer&) = delete;
+
+    ~allocator_buffer() {
+        destroy(m_data, m_data + m_size);
+        release_storage();
+    }
+
+    T* elements() {
+        return m_data;
+    }
+
+    const T* elements() const {
+        return m_data;
+    }
+
+    // False when the allocator is exhausted; the container's overflow
+    // policy then decides what happens to the element
+    bool acquire_storage(size_t = Capacity) {
+        if (m_data == nullptr) {
+            m_data = static_cast<T*>(Allocator::allocate(sizeof(T) * Capacity));
+        }
+        return m_data != nullptr;
+    }
+
+    // The block is only taken while the container is empty
+    bool keeps_elements(size_t) const {
+        return true;
+    }
+
+    // Returns the block to the allocator; the container must be empty
+    void release_storage() {
+        if (m_data != nullptr) {
+            Allocator::deallocate(m_data, sizeof(T) * Capacity);
+            m_data = nullptr;
+        }
+    }
+
+    // Exchanges the blocks with their elements, so moves and swaps never
+    // need a second block from the allocator. Always succeeds: a side
+    // without a block has no elements.
+    bool swap_storage(allocator_buffer& other) {
+        T* data = m_data;
+        m_data = other.m_data;
+        other.m_data = data;
+        typename capacity_size_type<Capacity>::type size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+        return true;
+    }
+
+    T* m_data;
+    typename capacity_size_type<Capacity>::type m_size;
+};
+
+// The first InlineN elements live inline; a container that needs more takes
+// one block of Capacity elements from Allocator and keeps it until it is
+// emptied. The inline area stays reserved while spilled, so getting the
+// block never has to move anything but the live elements.
+template <typename T, size_t Capacity, size_t InlineN, typename Allocator>
+struct small_buffer {
+    static_assert(InlineN > 0 && InlineN <= Capacity, "small_storage needs 0 < InlineN <= Capacity");
+    static_assert(alignof(T) <= Allocator::alignment,
+                  "allocator does not provide the alignment T requires");
+
+    constexpr small_buffer() : m_storage(), m_heap(nullptr), m_size(0) {}
+
+    small_buffer(const small_buffer&) = delete;
+    small_buffer& operator=(const small_buffer&) = delete;
+
+    ~small_buffer() {
+        destroy(elements(), elements() + m_size);
+        release_storage();
+    }
+
+    T* elements() {
+        return m_heap ? m_heap : reinterpret_cast<T*>(m_storage.m_bytes);
+    }
+
+    const T* elements() const {
+        return m_heap ? m_heap : reinterpret_cast<const T*>(m_storage.m_bytes);
+    }
+
+    // Makes room for count elements, spilling to the allocator if needed.
+    // False when the allocator is exhausted (or null_allocator); the
+    // container's overflow policy then decides what happens.
+    bool acquire_storage(size_t count = Capacity) {
+        if (count <= InlineN || m_heap != nullptr) {
+            return true;
+        }
+        T* block = static_cast<T*>(Allocator::allocate(sizeof(T) * Capacity));
+        if (block == nullptr) {
+            return false;
+        }
+        T* inline_elements = reinterpret_cast<T*>(m_storage.m_bytes);
+        uninitialized_move(inline_elements, inline_elements + m_size, block);
+        destroy(inline_elements, inline_elements + m_size);
+        m_heap = block;
+        ESTL_SPILL_HOOK(this, sizeof(T) * Capacity);
+        return true;
+    }
+
+    // False when acquire_storage(count) would spill, moving the elements
+    bool keeps_elements(size_t count) const {
+        return count <= InlineN || m_heap != nullptr;
+    }
+
+    // Returns to the inline area; the container must be empty
+    void release_storage() {
+        if (m_heap != nullptr) {
+            Allocator::deallocate(m_heap, sizeof(T) * Capacity);
+            m_heap = nullptr;
+        }
+    }
+
+    // Exchanges the heap blocks when either side has spilled, so moves and
+    // swaps never allocate. A spilled side's inline area is unused, so it
+    // takes the other side's inline elements. False when neither side has
+    // spilled; the elements are then exchanged one by one.
+    bool swap_storage(small_buffer& other) {
+        if (m_heap == nullptr && other.m_heap == nullptr) {
+            return false;
+        }
+        if (m_heap == nullptr) {
+            return other.swap_storage(*this);
+        }
+        if (other.m_heap == nullptr) {
+            T* inline_elements = reinterpret_cast<T*>(m_storage.m_bytes);
+            T* other_inline = reinterpret_cast<T*>(other.m_storage.m_bytes);
+            uninitialized_move(other_inline, other_inline + other.m_size, inline_elements);
+            destroy(other_inline, other_inline + other.m_size);
+        }
+        T* heap = m_heap;
+        m_heap = other.m_heap;
+        other.m_heap = heap;
+        typename capacity_size_type<Capacity>::type size = m_size;
+        m_size = other.m_size;
+        other.m_size = size;
+        return true;
+    }
+
+    inline_storage<T, InlineN> m_storage;
+    T* m_heap;
+    typename capacity_size_type<Capacity>::type m_size;
+};
+
+} // namespace detail
+
+/**
+ * @brief Storage policy keeping all Capacity elements inside the container
+ *
+ * The default for vector and map: no allocation, worst case reserved inline.
+ */
+struct static_storage {
+    template <typename T, size_t Capacity>
+    using buffer = detail::inline_buffer<T, Capacity>;
+};
+
+/**
+ * @brief Storage policy drawing the element block from an allocator
+ *
+ * The container takes one block of Capacity elements on its first insertion
+ * and gives it back on clear() or destruction, so containers that are never
+ * full at the same time can share one arena (see pool_allocator). An
+ * exhausted allocator counts as a full container: the insertion meets the
+ * container's overflow policy.
+ *
+ * @tparam Allocator A type with static allocate(size) returning nullptr on
+ *         failure, static deallocate(ptr, size) and a static alignment constant
+ */
+template <typename Allocator>
+struct allocator_storage {
+    template <typename T, size_t Capacity>
+    using buffer = detail::allocator_buffer<T, Capacity, Allocator>;
+};
+
+/**
+ * @brief Storage policy keeping InlineN elements inline and spilling beyond
+ *
+ * For containers that are usually small but occasionally large: only InlineN
+ * elements are reserved in each instance, and the few that grow past it take
+ * a block of Capacity elements from Allocator until they are cleared. With
+ * null_allocator, or once the allocator is exhausted, the container holds
+ * at most InlineN elements and further insertions meet its overflow policy.
+ * ESTL_SPILL_HOOK reports every spill (see config.hpp).
+ *
+ * @tparam InlineN The number of elements stored inline
+ * @tparam Allocator As for allocator_storage
+ */
+template <size_t InlineN, typename Allocator>
+struct small_storage {
+    template <typename T, size_t Capacity>
+    using buffer = detail::small_buffer<T, Capacity, InlineN, Allocator>;
+};
+
+} // namespace estl
+
+#endif // ESTL_MEMORY_HPP
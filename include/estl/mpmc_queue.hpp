@@ -0,0 +1,226 @@
+#ifndef ESTL_MPMC_QUEUE_HPP
+#define ESTL_MPMC_QUEUE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "memory.hpp"
+#include "atomic.hpp"
+
+namespace estl {
+
+#if ESTL_HAS_ATOMIC
+
+namespace detail {
+
+// Storage, per-slot sequence numbers and positions for mpmc_queue. Each
+// sequence is stored relative to its slot index, so the zero-initialized
+// array is an empty queue and the queue is constant-initialized into .bss.
+template <typename T, size_t Capacity>
+struct mpmc_buffer_base {
+    static constexpr size_t line_align = (ESTL_CACHE_LINE_SIZE > alignof(atomic_value<size_t>))
+        ? ESTL_CACHE_LINE_SIZE : alignof(atomic_value<size_t>);
+
+    constexpr mpmc_buffer_base() : m_storage(), m_sequence(), m_enqueue(), m_dequeue() {}
+
+    T* elements() {
+        return reinterpret_cast<T*>(m_storage.m_bytes);
+    }
+
+    // Sequence of the slot that position pos maps to
+    size_t sequence(size_t pos) const {
+        return m_sequence[pos & (Capacity - 1)].load_acquire() + (pos & (Capacity - 1));
+    }
+
+    void publish(size_t pos, size_t sequence) {
+        m_sequence[pos & (Capacity - 1)].store_release(sequence - (pos & (Capacity - 1)));
+    }
+
+    inline_storage<T, Capacity> m_storage;
+    atomic_value<size_t> m_sequence[Capacity];
+    // Claimed by producers
+    alignas(line_align) atomic_value<size_t> m_enqueue;
+    // Claimed by consumers
+    alignas(line_align) atomic_value<size_t> m_dequeue;
+};
+
+template <typename T, size_t Capacity>
+constexpr size_t mpmc_buffer_base<T, Capacity>::line_align;
+
+template <typename T, size_t Capacity, bool = std::is_trivially_destructible<T>::value>
+struct mpmc_buffer : mpmc_buffer_base<T, Capacity> {
+    constexpr mpmc_buffer() : mpmc_buffer_base<T, Capacity>() {}
+};
+
+// Destroys what is left, once no producer or consumer is running
+template <typename T, size_t Capacity>
+struct mpmc_buffer<T, Capacity, false> : mpmc_buffer_base<T, Capacity> {
+    constexpr mpmc_buffer() : mpmc_buffer_base<T, Capacity>() {}
+
+    ~mpmc_buffer() {
+        size_t end = this->m_enqueue.load_relaxed();
+        for (size_t pos = this->m_dequeue.load_relaxed(); pos != end; ++pos) {
+            this->elements()[pos & (Capacity - 1)].~T();
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A lock-free bounded multi-producer/multi-consumer queue
+ *
+ * For several interrupts and tasks feeding one queue, e.g. log records
+ * drained by a flush task, without a critical section. This is Dmitry
+ * Vyukov's bounded queue: every slot carries a sequence number telling
+ * producers and consumers whose turn it is, so each side claims a position
+ * with one compare-exchange and the element itself is published with a
+ * release store of the slot's sequence. The orderings follow
+ * ESTL_ATOMIC_SEQ_CST.
+ *
+ * A push preempted between claiming its slot and publishing it (say by an
+ * interrupt that pushes too) holds back the consumers at that slot until it
+ * completes; pushes and pops never wait for each other, they fail instead.
+ * Only defined with ESTL_HAS_ATOMIC, and lock-free only on cores with a
+ * compare-exchange instruction (not ARMv6-M).
+ *
+ * @tparam T The type of elements
+ * @tparam Capacity The maximum number of elements, a power of two of at least 2
+ */
+template <typename T, size_t Capacity>
+class mpmc_queue : private detail::mpmc_buffer<T, Capacity> {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "mpmc_queue Capacity must be a power of two of at least 2");
+
+    using storage_base = detail::mpmc_buffer<T, Capacity>;
+    using storage_base::elements;
+    using storage_base::sequence;
+    using storage_base::publish;
+    using storage_base::m_enqueue;
+    using storage_base::m_dequeue;
+
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    // Constructors
+    constexpr mpmc_queue() : storage_base() {}
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    // Capacity - a snapshot while producers or consumers are running
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_type size() const {
+        size_t dequeue = m_dequeue.load_acquire();
+        size_t used = m_enqueue.load_acquire() - dequeue;
+        // A consumer may have moved past the enqueue position just read
+        return (used > Capacity) ? 0 : used;
+    }
+
+    size_type capacity() const {
+        return Capacity;
+    }
+
+    // Producer side, from any context; false when the queue is full
+    bool push(const T& value) {
+        return emplace(value);
+    }
+
+    bool push(T&& value) {
+        return emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        size_t pos = m_enqueue.load_relaxed();
+        for (;;) {
+            ptrdiff_t diff = static_cast<ptrdiff_t>(sequence(pos) - pos);
+            if (diff == 0) {
+                // The slot is free; on failure pos receives the new position
+                if (m_enqueue.compare_exchange_relaxed(pos, pos + 1)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The slot still holds the element from one lap earlier
+                return false;
+            } else {
+                pos = m_enqueue.load_relaxed();
+            }
+        }
+        new (&elements()[pos & mask]) T(std::forward<Args>(args)...);
+        publish(pos, pos + 1);
+        return true;
+    }
+
+    // Consumer side, from any context; false when the queue is empty
+    bool pop(T& value) {
+        return pop(&value, 1) == 1;
+    }
+
+    /**
+     * @brief Moves up to count elements out of the queue
+     *
+     * Claims the whole run of published elements at the head with a single
+     * compare-exchange, so a flush task drains a burst at the cost of one
+     * pop. The elements are in queue order.
+     *
+     * @return The number of elements popped, 0 if the queue is empty
+     */
+    size_type pop(T* data, size_type count) {
+        size_t pos = m_dequeue.load_relaxed();
+        size_type ready = 0;
+        while (count > 0) {
+            ptrdiff_t diff = 0;
+            for (ready = 0; ready < count; ++ready) {
+                diff = static_cast<ptrdiff_t>(sequence(pos + ready) - (pos + ready + 1));
+                if (diff != 0) {
+                    break;
+                }
+            }
+            if (ready == 0) {
+                if (diff < 0) {
+                    // Not yet published
+                    return 0;
+                }
+                // Another consumer took it
+                pos = m_dequeue.load_relaxed();
+                continue;
+            }
+            if (m_dequeue.compare_exchange_relaxed(pos, pos + ready)) {
+                break;
+            }
+            ready = 0;
+        }
+
+        for (size_type i = 0; i < ready; ++i) {
+            T& slot = elements()[(pos + i) & mask];
+            data[i] = std::move(slot);
+            slot.~T();
+            publish(pos + i, pos + i + Capacity);
+        }
+        return ready;
+    }
+
+private:
+    static constexpr size_type mask = Capacity - 1;
+};
+
+template <typename T, size_t Capacity>
+constexpr typename mpmc_queue<T, Capacity>::size_type mpmc_queue<T, Capacity>::mask;
+
+#endif // ESTL_HAS_ATOMIC
+
+} // namespace estl
+
+#endif // ESTL_MPMC_QUEUE_HPP
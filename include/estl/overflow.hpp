@@ -0,0 +1,126 @@
+#ifndef ESTL_OVERFLOW_HPP
+#define ESTL_OVERFLOW_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "config.hpp"
+#include "memory.hpp"
+
+namespace estl {
+
+/**
+ * @brief What a full container does with an element it has no room for
+ */
+enum class overflow_action {
+    reject,           // Drop the new element; the container is unchanged
+    overwrite_oldest, // Drop the first element (the smallest key of a map)
+    saturate          // Drop the last element (the largest key of a map)
+};
+
+/**
+ * Overflow policies for vector and map
+ *
+ * A policy is any type with a static constexpr overflow_action action and
+ * a static on_overflow(), which is called each time an element finds the
+ * container full (or its allocator exhausted) before the action is applied.
+ * Both are resolved at compile time, so an insertion still costs a single
+ * capacity check.
+ *
+ * Rejected insertions are reported by the return value: insert, emplace
+ * and emplace_back return end() (map: end() and false), try_emplace_back
+ * returns false. operator[] of a map has nothing to return for a rejected
+ * key, so there room is a precondition, asserted as at() asserts the key;
+ * callers that may meet a full map use try_emplace.
+ * try_emplace_back never evicts, whatever the policy, and vector's assign
+ * and resize still truncate to Capacity.
+ */
+
+// Asserts, then rejects: the behavior without a policy
+struct overflow_assert {
+    static constexpr overflow_action action = overflow_action::reject;
+
+    static void on_overflow() {
+        ESTL_ASSERT(false && "container capacity exceeded");
+    }
+};
+
+// Rejects silently; callers check the return value
+struct overflow_reject {
+    static constexpr overflow_action action = overflow_action::reject;
+
+    static void on_overflow() {}
+};
+
+// Evicts the first element, e.g. for a lossy telemetry log that keeps the
+// latest Capacity samples
+struct overflow_overwrite_oldest {
+    static constexpr overflow_action action = overflow_action::overwrite_oldest;
+
+    static void on_overflow() {}
+};
+
+// Evicts the last element so the newest one is always stored
+struct overflow_saturate {
+    static constexpr overflow_action action = overflow_action::saturate;
+
+    static void on_overflow() {}
+};
+
+// Calls Handler (e.g. to raise a fault flag), then applies Action
+template <void (*Handler)(), overflow_action Action = overflow_action::reject>
+struct overflow_handler {
+    static constexpr overflow_action action = Action;
+
+    static void on_overflow() {
+        Handler();
+    }
+};
+
+namespace detail {
+
+template <typename Overflow>
+using overflow_tag = std::integral_constant<overflow_action, Overflow::action>;
+
+// Frees a slot for an element to be inserted at index into the size live
+// elements of a full container, for the evicting actions. On success
+// data[index] is raw storage (index is moved to where the new element
+// belongs), size is unchanged and shifted holds the number of elements
+// moved. Only the elements between the evicted one and index move, so there
+// is no separate erase pass.
+template <typename T>
+bool open_overflow_slot(T* data, size_t size, size_t& index, size_t& shifted,
+                        std::integral_constant<overflow_action, overflow_action::overwrite_oldest>) {
+    if (size == 0) {
+        return false;
+    }
+    data[0].~T();
+    // An element going before the oldest one simply replaces it
+    if (index > 0) {
+        relocate_down(data, 0, index);
+        --index;
+    }
+    shifted = index;
+    return true;
+}
+
+template <typename T>
+bool open_overflow_slot(T* data, size_t size, size_t& index, size_t& shifted,
+                        std::integral_constant<overflow_action, overflow_action::saturate>) {
+    if (size == 0) {
+        return false;
+    }
+    data[size - 1].~T();
+    if (index >= size) {
+        index = size - 1;
+    } else {
+        relocate_up(data, index, size - 1);
+    }
+    shifted = size - 1 - index;
+    return true;
+}
+
+} // namespace detail
+
+} // namespace estl
+
+#endif // ESTL_OVERFLOW_HPP
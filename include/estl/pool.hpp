@@ -0,0 +1,229 @@
+#ifndef ESTL_POOL_HPP
+#define ESTL_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "config.hpp"
+
+namespace estl {
+
+/**
+ * @brief Usage counters reported by pool::statistics()
+ */
+struct pool_statistics {
+    size_t in_use;
+    size_t high_water;
+    size_t allocations;
+    size_t failed_allocations;
+};
+
+namespace detail {
+
+// Counters for pools built with Stats = true; the false specialization is
+// empty so pools without statistics pay nothing for them
+template <bool Stats>
+struct pool_counters {
+    constexpr pool_counters() : m_high_water(0), m_allocations(0), m_failed_allocations(0) {}
+
+    void record_allocation(size_t in_use) {
+        ++m_allocations;
+        if (in_use > m_high_water) {
+            m_high_water = in_use;
+        }
+    }
+
+    void record_failure() {
+        ++m_failed_allocations;
+    }
+
+    size_t m_high_water;
+    size_t m_allocations;
+    size_t m_failed_allocations;
+};
+
+template <>
+struct pool_counters<false> {
+    constexpr pool_counters() {}
+
+    void record_allocation(size_t) {}
+    void record_failure() {}
+};
+
+} // namespace detail
+
+/**
+ * @brief A fixed-block memory pool with O(1) allocate and deallocate
+ *
+ * Hands out BlockCount blocks of at least BlockSize bytes from static
+ * storage. Freed blocks are kept on an intrusive free list; blocks that were
+ * never handed out are taken in address order, so construction is constexpr
+ * and needs no initialization pass. The pool is not synchronized: callers
+ * sharing it between interrupts or threads must serialize access.
+ *
+ * @tparam BlockSize The minimum usable size of each block in bytes
+ * @tparam BlockCount The number of blocks
+ * @tparam Stats Whether to keep usage counters (see statistics())
+ */
+template <size_t BlockSize, size_t BlockCount, bool Stats = false>
+class pool : private detail::pool_counters<Stats> {
+    union block_link {
+        block_link* next;
+        alignas(std::max_align_t) unsigned char bytes[BlockSize];
+    };
+
+public:
+    static constexpr size_t block_size = sizeof(block_link);
+    static constexpr size_t block_count = BlockCount;
+    static constexpr size_t block_alignment = alignof(block_link);
+
+    constexpr pool() : m_blocks(), m_free(nullptr), m_untouched(0), m_in_use(0) {}
+
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+    /**
+     * @brief Takes one block from the pool
+     *
+     * @return A block of block_size bytes, or nullptr when the pool is exhausted
+     */
+    void* allocate() {
+        block_link* block;
+        if (m_free != nullptr) {
+            block = m_free;
+            m_free = block->next;
+        } else if (m_untouched < BlockCount) {
+            block = &m_blocks[m_untouched++];
+        } else {
+            this->record_failure();
+            return nullptr;
+        }
+
+        ++m_in_use;
+        this->record_allocation(m_in_use);
+        return block;
+    }
+
+    void deallocate(void* ptr) {
+        if (ptr == nullptr) {
+            return;
+        }
+        ESTL_ASSERT(owns(ptr));
+
+        block_link* block = static_cast<block_link*>(ptr);
+        block->next = m_free;
+        m_free = block;
+        --m_in_use;
+    }
+
+    bool owns(const void* ptr) const {
+        uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+        uintptr_t first = reinterpret_cast<uintptr_t>(m_blocks);
+        uintptr_t last = reinterpret_cast<uintptr_t>(m_blocks + BlockCount);
+        return address >= first && address < last && (address - first) % sizeof(block_link) == 0;
+    }
+
+    size_t available() const {
+        return BlockCount - m_in_use;
+    }
+
+    size_t in_use() const {
+        return m_in_use;
+    }
+
+    pool_statistics statistics() const {
+        static_assert(Stats, "pool statistics require Stats = true");
+        pool_statistics stats;
+        stats.in_use = m_in_use;
+        stats.high_water = this->m_high_water;
+        stats.allocations = this->m_allocations;
+        stats.failed_allocations = this->m_failed_allocations;
+        return stats;
+    }
+
+private:
+    block_link m_blocks[BlockCount];
+    block_link* m_free;
+    size_t m_untouched;
+    size_t m_in_use;
+};
+
+template <size_t BlockSize, size_t BlockCount, bool Stats>
+constexpr size_t pool<BlockSize, BlockCount, Stats>::block_size;
+
+template <size_t BlockSize, size_t BlockCount, bool Stats>
+constexpr size_t pool<BlockSize, BlockCount, Stats>::block_count;
+
+template <size_t BlockSize, size_t BlockCount, bool Stats>
+constexpr size_t pool<BlockSize, BlockCount, Stats>::block_alignment;
+
+/**
+ * @brief Allocator adapter drawing container storage from a static pool
+ *
+ * Usage:
+ *   estl::pool<1024, 4> g_arena;
+ *   using arena = estl::pool_allocator<decltype(g_arena), g_arena>;
+ *   estl::vector<Sample, 256, estl::allocator_storage<arena>> samples;
+ *
+ * @tparam Pool The pool type
+ * @tparam Instance The pool object all containers using this allocator share;
+ *         C++11 requires it to have external linkage (not static)
+ */
+template <typename Pool, Pool& Instance>
+struct pool_allocator {
+    static constexpr size_t alignment = Pool::block_alignment;
+
+    static void* allocate(size_t size) {
+        ESTL_ASSERT(size <= Pool::block_size);
+        return (size <= Pool::block_size) ? Instance.allocate() : nullptr;
+    }
+
+    static void deallocate(void* ptr, size_t) {
+        Instance.deallocate(ptr);
+    }
+};
+
+template <typename Pool, Pool& Instance>
+constexpr size_t pool_allocator<Pool, Instance>::alignment;
+
+/**
+ * @brief Allocator that never provides memory
+ *
+ * For storage policies that should not allocate, e.g. small_storage in
+ * builds without an arena or ESTL_USE_DYNAMIC_MEMORY.
+ */
+struct null_allocator {
+    static constexpr size_t alignment = alignof(std::max_align_t);
+
+    static void* allocate(size_t) {
+        return nullptr;
+    }
+
+    static void deallocate(void*, size_t) {}
+};
+
+#if ESTL_USE_DYNAMIC_MEMORY
+/**
+ * @brief Allocator using the global heap, available with ESTL_USE_DYNAMIC_MEMORY
+ */
+struct heap_allocator {
+    static constexpr size_t alignment = alignof(std::max_align_t);
+
+    static void* allocate(size_t size) {
+        return ::operator new(size, std::nothrow);
+    }
+
+    static void deallocate(void* ptr, size_t) {
+        ::operator delete(ptr);
+    }
+};
+
+// Allocator used when a container is not given one
+using default_allocator = heap_allocator;
+#else
+using default_allocator = null_allocator;
+#endif
+
+} // namespace estl
+
+#endif // ESTL_POOL_HPP
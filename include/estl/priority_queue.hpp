@@ -0,0 +1,414 @@
+#ifndef ESTL_PRIORITY_QUEUE_HPP
+#define ESTL_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+#include "vector.hpp"
+
+namespace estl {
+
+/**
+ * @brief A fixed-capacity priority queue on inline storage
+ *
+ * A binary max-heap over estl::vector, like std::priority_queue: top() is an
+ * element no other compares greater than (use greater<T> for the earliest
+ * deadline first). push and pop are O(log N) with no allocation.
+ *
+ * @tparam T The type of elements
+ * @tparam Capacity The maximum number of elements
+ * @tparam Compare The comparison function object type
+ */
+template <typename T, size_t Capacity, typename Compare = less<T>>
+class priority_queue {
+public:
+    // Type definitions
+    using container_type = vector<T, Capacity>;
+    using value_type = T;
+    using size_type = size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using value_compare = Compare;
+
+    // Constructors
+    constexpr priority_queue() : m_items() {}
+
+    template <typename InputIt>
+    priority_queue(InputIt first, InputIt last) : m_items() {
+        for (; first != last && m_items.size() < Capacity; ++first) {
+            m_items.push_back(*first);
+        }
+        // Range larger than the capacity
+        ESTL_ASSERT(first == last);
+        estl::make_heap(m_items.begin(), m_items.end(), Compare());
+    }
+
+    // Element access
+    const_reference top() const {
+        ESTL_ASSERT(!m_items.empty());
+        return m_items.front();
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_items.empty();
+    }
+
+    bool full() const {
+        return m_items.size() == Capacity;
+    }
+
+    size_type size() const {
+        return m_items.size();
+    }
+
+    size_type max_size() const {
+        return Capacity;
+    }
+
+    size_type capacity() const {
+        return Capacity;
+    }
+
+    // Modifiers
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (!full()) {
+            m_items.emplace_back(std::forward<Args>(args)...);
+            estl::push_heap(m_items.begin(), m_items.end(), Compare());
+        } else {
+            // Handle capacity exceeded
+            ESTL_ASSERT(!full());
+        }
+    }
+
+    /**
+     * @brief Constructs an element in the queue if there is room
+     *
+     * @return true if the element was added, false if the queue is full
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        if (!m_items.try_emplace_back(std::forward<Args>(args)...)) {
+            return false;
+        }
+        estl::push_heap(m_items.begin(), m_items.end(), Compare());
+        return true;
+    }
+
+    void pop() {
+        ESTL_ASSERT(!m_items.empty());
+        estl::pop_heap(m_items.begin(), m_items.end(), Compare());
+        m_items.pop_back();
+    }
+
+    void clear() {
+        m_items.clear();
+    }
+
+    void swap(priority_queue& other) {
+        m_items.swap(other.m_items);
+    }
+
+    // Observers
+    value_compare value_comp() const {
+        return Compare();
+    }
+
+private:
+    container_type m_items;
+};
+
+namespace detail {
+
+// Element slots plus the heap of handles. m_heap[0, m_size) is the heap;
+// m_heap[m_size, m_used) holds released handles for reuse, and handles at
+// or above m_used have never been issued, so nothing needs initializing.
+// m_pos[h] is the index of handle h in m_heap.
+template <typename T, size_t Capacity>
+struct indexed_heap_base {
+    using index_type = typename capacity_size_type<Capacity>::type;
+
+    constexpr indexed_heap_base() : m_slots(), m_heap(), m_pos(), m_size(0), m_used(0) {}
+
+    T* slots() {
+        return reinterpret_cast<T*>(m_slots.m_bytes);
+    }
+
+    const T* slots() const {
+        return reinterpret_cast<const T*>(m_slots.m_bytes);
+    }
+
+    void destroy_all() {
+        for (size_t i = 0; i < m_size; ++i) {
+            slots()[m_heap[i]].~T();
+        }
+    }
+
+    inline_storage<T, Capacity> m_slots;
+    index_type m_heap[Capacity];
+    index_type m_pos[Capacity];
+    index_type m_size;
+    index_type m_used;
+};
+
+template <typename T, size_t Capacity, bool = std::is_trivially_destructible<T>::value>
+struct indexed_heap_buffer : indexed_heap_base<T, Capacity> {
+    constexpr indexed_heap_buffer() : indexed_heap_base<T, Capacity>() {}
+};
+
+template <typename T, size_t Capacity>
+struct indexed_heap_buffer<T, Capacity, false> : indexed_heap_base<T, Capacity> {
+    constexpr indexed_heap_buffer() : indexed_heap_base<T, Capacity>() {}
+
+    ~indexed_heap_buffer() {
+        this->destroy_all();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A fixed-capacity priority queue with handles to its elements
+ *
+ * push() returns a handle that stays valid, whatever the element's position
+ * in the heap, until that element is popped or erased; a timer can keep it
+ * and later cancel (erase) or re-arm (update) in O(log N) without a search.
+ * Elements never move: the heap orders handles, so sifting swaps small
+ * integers however large T is. Released handles are reused by later pushes.
+ *
+ * @tparam T The type of elements
+ * @tparam Capacity The maximum number of elements
+ * @tparam Compare The comparison function object type
+ */
+template <typename T, size_t Capacity, typename Compare = less<T>>
+class indexed_priority_queue : private detail::indexed_heap_buffer<T, Capacity> {
+    using storage_base = detail::indexed_heap_buffer<T, Capacity>;
+    using storage_base::slots;
+    using storage_base::m_heap;
+    using storage_base::m_pos;
+    using storage_base::m_size;
+    using storage_base::m_used;
+
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using value_compare = Compare;
+    using handle_type = typename detail::capacity_size_type<Capacity>::type;
+
+    // Returned by emplace() on a full queue; contains() rejects it
+    static constexpr handle_type invalid_handle = static_cast<handle_type>(Capacity);
+
+    // Constructors
+    constexpr indexed_priority_queue() : storage_base() {}
+
+    indexed_priority_queue(const indexed_priority_queue&) = delete;
+    indexed_priority_queue& operator=(const indexed_priority_queue&) = delete;
+
+    // Element access
+    const_reference top() const {
+        ESTL_ASSERT(m_size > 0);
+        return slots()[m_heap[0]];
+    }
+
+    handle_type top_handle() const {
+        ESTL_ASSERT(m_size > 0);
+        return m_heap[0];
+    }
+
+    const_reference operator[](handle_type handle) const {
+        ESTL_ASSERT(contains(handle));
+        return slots()[handle];
+    }
+
+    // Whether handle refers to an element in the queue
+    bool contains(handle_type handle) const {
+        return handle < m_used && m_pos[handle] < m_size;
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    bool full() const {
+        return m_size == Capacity;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    size_type max_size() const {
+        return Capacity;
+    }
+
+    size_type capacity() const {
+        return Capacity;
+    }
+
+    // Modifiers
+    handle_type push(const T& value) {
+        return emplace(value);
+    }
+
+    handle_type push(T&& value) {
+        return emplace(std::move(value));
+    }
+
+    // Returns invalid_handle if the queue is full
+    template <typename... Args>
+    handle_type emplace(Args&&... args) {
+        if (full()) {
+            // Handle capacity exceeded
+            ESTL_ASSERT(!full());
+            return invalid_handle;
+        }
+        handle_type handle = acquire_handle();
+        new (&slots()[handle]) T(std::forward<Args>(args)...);
+        ++m_size;
+        sift_up(m_size - 1);
+        return handle;
+    }
+
+    /**
+     * @brief Constructs an element in the queue if there is room
+     *
+     * @return true and the element's handle in *handle, or false if full
+     */
+    template <typename... Args>
+    bool try_emplace(handle_type* handle, Args&&... args) {
+        if (full()) {
+            return false;
+        }
+        *handle = emplace(std::forward<Args>(args)...);
+        return true;
+    }
+
+    void pop() {
+        ESTL_ASSERT(m_size > 0);
+        remove_at(0);
+    }
+
+    void erase(handle_type handle) {
+        ESTL_ASSERT(contains(handle));
+        remove_at(m_pos[handle]);
+    }
+
+    // Replaces the element and restores the order, in O(log N)
+    void update(handle_type handle, const T& value) {
+        ESTL_ASSERT(contains(handle));
+        slots()[handle] = value;
+        restore(m_pos[handle]);
+    }
+
+    void update(handle_type handle, T&& value) {
+        ESTL_ASSERT(contains(handle));
+        slots()[handle] = std::move(value);
+        restore(m_pos[handle]);
+    }
+
+    void clear() {
+        this->destroy_all();
+        m_size = 0;
+        m_used = 0;
+    }
+
+    // Observers
+    value_compare value_comp() const {
+        return Compare();
+    }
+
+private:
+    handle_type acquire_handle() {
+        if (m_size == m_used) {
+            m_heap[m_size] = m_used;
+            m_pos[m_used] = m_size;
+            ++m_used;
+        }
+        return m_heap[m_size];
+    }
+
+    bool less_at(size_type a, size_type b) const {
+        return Compare()(slots()[m_heap[a]], slots()[m_heap[b]]);
+    }
+
+    void swap_at(size_type a, size_type b) {
+        handle_type ha = m_heap[a];
+        handle_type hb = m_heap[b];
+        m_heap[a] = hb;
+        m_heap[b] = ha;
+        m_pos[hb] = static_cast<handle_type>(a);
+        m_pos[ha] = static_cast<handle_type>(b);
+    }
+
+    // Destroys the element at heap index i and parks its handle just past
+    // the heap for reuse
+    void remove_at(size_type i) {
+        slots()[m_heap[i]].~T();
+        --m_size;
+        if (i != m_size) {
+            swap_at(i, m_size);
+            restore(i);
+        }
+    }
+
+    void restore(size_type i) {
+        if (i > 0 && less_at((i - 1) / 2, i)) {
+            sift_up(i);
+        } else {
+            sift_down(i);
+        }
+    }
+
+    void sift_up(size_type i) {
+        while (i > 0) {
+            size_type parent = (i - 1) / 2;
+            if (!less_at(parent, i)) {
+                break;
+            }
+            swap_at(parent, i);
+            i = parent;
+        }
+    }
+
+    void sift_down(size_type i) {
+        for (;;) {
+            size_type child = 2 * i + 1;
+            if (child >= m_size) {
+                break;
+            }
+            if (child + 1 < m_size && less_at(child, child + 1)) {
+                ++child;
+            }
+            if (!less_at(i, child)) {
+                break;
+            }
+            swap_at(i, child);
+            i = child;
+        }
+    }
+};
+
+template <typename T, size_t Capacity, typename Compare>
+constexpr typename indexed_priority_queue<T, Capacity, Compare>::handle_type
+    indexed_priority_queue<T, Capacity, Compare>::invalid_handle;
+
+} // namespace estl
+
+#endif // ESTL_PRIORITY_QUEUE_HPP
@@ -0,0 +1,311 @@
+#ifndef ESTL_SIMD_HPP
+#define ESTL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "config.hpp"
+#include "bit.hpp"
+
+#if ESTL_SIMD == ESTL_SIMD_AVX2
+    #include <immintrin.h>
+#elif ESTL_SIMD == ESTL_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace estl {
+
+namespace detail {
+
+// Element types the kernels accept: the standard integer types of 1, 2 or
+// 4 bytes. Kernels work on the unsigned counterpart, which may alias them.
+template <typename T>
+struct is_simd_integer : std::integral_constant<bool,
+    std::is_same<T, char>::value ||
+    std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value ||
+    std::is_same<T, short>::value || std::is_same<T, unsigned short>::value ||
+    std::is_same<T, int>::value || std::is_same<T, unsigned int>::value ||
+    std::is_same<T, long>::value || std::is_same<T, unsigned long>::value> {};
+
+#if ESTL_SIMD == ESTL_SIMD_SWAR
+using swar_word = uintptr_t;
+#endif
+
+template <typename T>
+struct is_vectorizable : std::integral_constant<bool,
+    is_simd_integer<typename std::remove_const<T>::type>::value &&
+#if ESTL_SIMD == ESTL_SIMD_SWAR
+    // A word must hold at least two lanes to gain anything
+    sizeof(T) < sizeof(swar_word) &&
+#endif
+    sizeof(T) <= 4 && ESTL_SIMD != ESTL_SIMD_NONE> {};
+
+// True for pointers to vectorizable elements
+template <typename It>
+struct is_vectorizable_range : std::false_type {};
+
+template <typename T>
+struct is_vectorizable_range<T*> : is_vectorizable<T> {};
+
+// Bit helpers for the comparison masks
+inline unsigned lowest_set_bit(uint32_t mask) {
+    return static_cast<unsigned>(estl::countr_zero(mask));
+}
+
+inline unsigned population_count(uint32_t mask) {
+    return static_cast<unsigned>(estl::popcount(mask));
+}
+
+#if ESTL_SIMD == ESTL_SIMD_SSE2 || ESTL_SIMD == ESTL_SIMD_AVX2
+
+#if ESTL_SIMD == ESTL_SIMD_AVX2
+using simd_register = __m256i;
+
+inline simd_register simd_load(const void* ptr) {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+}
+
+inline void simd_store(void* ptr, simd_register value) {
+    _mm256_storeu_si256(static_cast<__m256i*>(ptr), value);
+}
+
+// One bit per byte of the register
+inline uint32_t simd_byte_mask(simd_register value) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(value));
+}
+
+template <size_t LaneSize>
+struct simd_lanes;
+
+template <>
+struct simd_lanes<1> {
+    static simd_register splat(uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+    static simd_register equal(simd_register a, simd_register b) { return _mm256_cmpeq_epi8(a, b); }
+};
+
+template <>
+struct simd_lanes<2> {
+    static simd_register splat(uint16_t value) { return _mm256_set1_epi16(static_cast<short>(value)); }
+    static simd_register equal(simd_register a, simd_register b) { return _mm256_cmpeq_epi16(a, b); }
+};
+
+template <>
+struct simd_lanes<4> {
+    static simd_register splat(uint32_t value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+    static simd_register equal(simd_register a, simd_register b) { return _mm256_cmpeq_epi32(a, b); }
+};
+#else
+using simd_register = __m128i;
+
+inline simd_register simd_load(const void* ptr) {
+    return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+
+inline void simd_store(void* ptr, simd_register value) {
+    _mm_storeu_si128(static_cast<__m128i*>(ptr), value);
+}
+
+// One bit per byte of the register
+inline uint32_t simd_byte_mask(simd_register value) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(value));
+}
+
+template <size_t LaneSize>
+struct simd_lanes;
+
+template <>
+struct simd_lanes<1> {
+    static simd_register splat(uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+    static simd_register equal(simd_register a, simd_register b) { return _mm_cmpeq_epi8(a, b); }
+};
+
+template <>
+struct simd_lanes<2> {
+    static simd_register splat(uint16_t value) { return _mm_set1_epi16(static_cast<short>(value)); }
+    static simd_register equal(simd_register a, simd_register b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+template <>
+struct simd_lanes<4> {
+    static simd_register splat(uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); }
+    static simd_register equal(simd_register a, simd_register b) { return _mm_cmpeq_epi32(a, b); }
+};
+#endif
+
+template <typename U>
+const U* simd_find(const U* first, const U* last, U value) {
+    const ptrdiff_t per_register = sizeof(simd_register) / sizeof(U);
+    const simd_register needle = simd_lanes<sizeof(U)>::splat(value);
+    for (; last - first >= per_register; first += per_register) {
+        uint32_t mask = simd_byte_mask(simd_lanes<sizeof(U)>::equal(simd_load(first), needle));
+        if (mask != 0) {
+            return first + lowest_set_bit(mask) / sizeof(U);
+        }
+    }
+    for (; first != last && *first != value; ++first) {}
+    return first;
+}
+
+template <typename U>
+size_t simd_count(const U* first, const U* last, U value) {
+    const ptrdiff_t per_register = sizeof(simd_register) / sizeof(U);
+    const simd_register needle = simd_lanes<sizeof(U)>::splat(value);
+    size_t result = 0;
+    for (; last - first >= per_register; first += per_register) {
+        uint32_t mask = simd_byte_mask(simd_lanes<sizeof(U)>::equal(simd_load(first), needle));
+        result += population_count(mask) / sizeof(U);
+    }
+    for (; first != last; ++first) {
+        result += (*first == value) ? 1 : 0;
+    }
+    return result;
+}
+
+template <typename U>
+void simd_fill(U* first, U* last, U value) {
+    const ptrdiff_t per_register = sizeof(simd_register) / sizeof(U);
+    const simd_register pattern = simd_lanes<sizeof(U)>::splat(value);
+    for (; last - first >= per_register; first += per_register) {
+        simd_store(first, pattern);
+    }
+    for (; first != last; ++first) {
+        *first = value;
+    }
+}
+
+#elif ESTL_SIMD == ESTL_SIMD_SWAR
+
+// Word-at-a-time kernels. The unaligned head is handled element-wise so the
+// word loop only issues aligned loads and stores, which matters on cores
+// without (or with slow) unaligned access.
+
+inline swar_word swar_load(const void* ptr) {
+    swar_word word;
+#if defined(__GNUC__)
+    std::memcpy(&word, __builtin_assume_aligned(ptr, sizeof(swar_word)), sizeof(word));
+#else
+    std::memcpy(&word, ptr, sizeof(word));
+#endif
+    return word;
+}
+
+inline void swar_store(void* ptr, swar_word word) {
+#if defined(__GNUC__)
+    std::memcpy(__builtin_assume_aligned(ptr, sizeof(swar_word)), &word, sizeof(word));
+#else
+    std::memcpy(ptr, &word, sizeof(word));
+#endif
+}
+
+// The lowest bit of every lane set, e.g. 0x01010101 for byte lanes
+template <typename U>
+constexpr swar_word swar_low() {
+    return ~static_cast<swar_word>(0) / static_cast<U>(~static_cast<U>(0));
+}
+
+template <typename U>
+constexpr swar_word swar_high() {
+    return swar_low<U>() << (8 * sizeof(U) - 1);
+}
+
+// High bit set in exactly the lanes of word that are zero; no carries cross lanes
+template <typename U>
+inline swar_word swar_zero_lanes(swar_word word) {
+    const swar_word low_bits = ~swar_high<U>();
+    return ~(((word & low_bits) + low_bits) | word | low_bits);
+}
+
+template <typename U>
+inline bool swar_is_aligned(const U* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) % sizeof(swar_word) == 0;
+}
+
+template <typename U>
+const U* simd_find(const U* first, const U* last, U value) {
+    const ptrdiff_t per_word = sizeof(swar_word) / sizeof(U);
+    for (; first != last && !swar_is_aligned(first); ++first) {
+        if (*first == value) {
+            return first;
+        }
+    }
+
+    // Stop at the first word holding a match and let the element loop find it
+    const swar_word pattern = swar_low<U>() * value;
+    for (; last - first >= per_word; first += per_word) {
+        if (swar_zero_lanes<U>(swar_load(first) ^ pattern) != 0) {
+            break;
+        }
+    }
+    for (; first != last && *first != value; ++first) {}
+    return first;
+}
+
+template <typename U>
+size_t simd_count(const U* first, const U* last, U value) {
+    const ptrdiff_t per_word = sizeof(swar_word) / sizeof(U);
+    size_t result = 0;
+    for (; first != last && !swar_is_aligned(first); ++first) {
+        result += (*first == value) ? 1 : 0;
+    }
+
+    // Matching lanes become 1, and multiplying by swar_low sums them into the top lane
+    const swar_word pattern = swar_low<U>() * value;
+    for (; last - first >= per_word; first += per_word) {
+        swar_word matches = swar_zero_lanes<U>(swar_load(first) ^ pattern) >> (8 * sizeof(U) - 1);
+        result += static_cast<size_t>((matches * swar_low<U>()) >> (8 * (sizeof(swar_word) - sizeof(U))));
+    }
+    for (; first != last; ++first) {
+        result += (*first == value) ? 1 : 0;
+    }
+    return result;
+}
+
+template <typename U>
+void simd_fill(U* first, U* last, U value) {
+    const ptrdiff_t per_word = sizeof(swar_word) / sizeof(U);
+    for (; first != last && !swar_is_aligned(first); ++first) {
+        *first = value;
+    }
+
+    const swar_word pattern = swar_low<U>() * value;
+    for (; last - first >= per_word; first += per_word) {
+        swar_store(first, pattern);
+    }
+    for (; first != last; ++first) {
+        *first = value;
+    }
+}
+
+#else
+
+// Scalar reference versions; unused while is_vectorizable is false
+template <typename U>
+const U* simd_find(const U* first, const U* last, U value) {
+    for (; first != last && *first != value; ++first) {}
+    return first;
+}
+
+template <typename U>
+size_t simd_count(const U* first, const U* last, U value) {
+    size_t result = 0;
+    for (; first != last; ++first) {
+        result += (*first == value) ? 1 : 0;
+    }
+    return result;
+}
+
+template <typename U>
+void simd_fill(U* first, U* last, U value) {
+    for (; first != last; ++first) {
+        *first = value;
+    }
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace estl
+
+#endif // ESTL_SIMD_HPP
@@ -0,0 +1,233 @@
+#ifndef ESTL_SLIDING_MEDIAN_HPP
+#define ESTL_SLIDING_MEDIAN_HPP
+
+#include <cstddef>
+#include "config.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// One half of a sliding_median: a binary heap of window slots ordered by
+// the values they hold. Each slot's heap position is recorded so the slot
+// leaving the window can be removed in O(log N) from anywhere in the heap.
+template <typename T, typename Index, size_t Capacity, typename Compare, bool Max>
+class median_heap {
+public:
+    constexpr median_heap() : m_slots(), m_size(0) {}
+
+    size_t size() const {
+        return m_size;
+    }
+
+    Index top() const {
+        return m_slots[0];
+    }
+
+    void push(Index slot, const T* values, Index* positions) {
+        m_slots[m_size] = slot;
+        sift_up(m_size++, values, positions);
+    }
+
+    void remove(Index position, const T* values, Index* positions) {
+        Index last = m_slots[--m_size];
+        if (position == m_size) {
+            return;
+        }
+        // The moved slot goes up or down, never both
+        m_slots[position] = last;
+        sift_up(position, values, positions);
+        sift_down(positions[last], values, positions);
+    }
+
+    Index pop(const T* values, Index* positions) {
+        Index slot = m_slots[0];
+        remove(0, values, positions);
+        return slot;
+    }
+
+    void clear() {
+        m_size = 0;
+    }
+
+private:
+    // True when slot a belongs above slot b
+    static bool above(const T* values, Index a, Index b) {
+        return Max ? Compare()(values[b], values[a]) : Compare()(values[a], values[b]);
+    }
+
+    void sift_up(Index position, const T* values, Index* positions) {
+        Index slot = m_slots[position];
+        while (position > 0) {
+            Index parent = static_cast<Index>((position - 1) / 2);
+            if (!above(values, slot, m_slots[parent])) {
+                break;
+            }
+            m_slots[position] = m_slots[parent];
+            positions[m_slots[position]] = position;
+            position = parent;
+        }
+        m_slots[position] = slot;
+        positions[slot] = position;
+    }
+
+    void sift_down(Index position, const T* values, Index* positions) {
+        Index slot = m_slots[position];
+        for (;;) {
+            size_t child = 2 * static_cast<size_t>(position) + 1;
+            if (child >= m_size) {
+                break;
+            }
+            if (child + 1 < m_size && above(values, m_slots[child + 1], m_slots[child])) {
+                ++child;
+            }
+            if (!above(values, m_slots[child], slot)) {
+                break;
+            }
+            m_slots[position] = m_slots[child];
+            positions[m_slots[position]] = position;
+            position = static_cast<Index>(child);
+        }
+        m_slots[position] = slot;
+        positions[slot] = position;
+    }
+
+    Index m_slots[Capacity];
+    Index m_size;
+};
+
+} // namespace detail
+
+/**
+ * @brief Running median of the last Window samples
+ *
+ * For median filters on ADC streams: each push() replaces the oldest
+ * sample and median() is then read in O(1), instead of re-sorting the
+ * window (or an nth_element over it) per sample. The samples sit in a ring;
+ * the lower half of the window is a max-heap and the upper half a min-heap
+ * of ring slots, so a push costs O(log Window) comparisons in the worst case,
+ * not just on average. Nothing is allocated.
+ *
+ * Compare is default-constructed where needed, so it must be stateless.
+ *
+ * @tparam T The sample type, default constructible and copy assignable
+ * @tparam Window The number of samples the median covers
+ * @tparam Compare The comparison function object type
+ */
+template <typename T, size_t Window, typename Compare = less<T>>
+class sliding_median {
+    static_assert(Window > 0, "sliding_median Window must not be zero");
+
+    using index_type = typename detail::capacity_size_type<Window>::type;
+    // Each half can briefly hold one sample over its share, between an
+    // insertion and the rebalancing that follows it
+    using lower_heap = detail::median_heap<T, index_type, (Window + 1) / 2 + 1, Compare, true>;
+    using upper_heap = detail::median_heap<T, index_type, Window / 2 + 1, Compare, false>;
+
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using const_reference = const T&;
+    using value_compare = Compare;
+
+    // Constructors
+    constexpr sliding_median()
+        : m_values(), m_positions(), m_in_lower(), m_lower(), m_upper(), m_count(0), m_oldest(0) {}
+
+    sliding_median(const sliding_median&) = delete;
+    sliding_median& operator=(const sliding_median&) = delete;
+
+    // Adds a sample, dropping the oldest one once the window is full
+    void push(const T& sample) {
+        index_type slot;
+        if (m_count == Window) {
+            slot = m_oldest;
+            m_oldest = static_cast<index_type>((slot + 1 == Window) ? 0 : slot + 1);
+            if (m_in_lower[slot]) {
+                m_lower.remove(m_positions[slot], m_values, m_positions);
+            } else {
+                m_upper.remove(m_positions[slot], m_values, m_positions);
+            }
+        } else {
+            slot = static_cast<index_type>(m_count++);
+        }
+        m_values[slot] = sample;
+
+        // Below every upper sample goes to the lower half; the eviction may
+        // have emptied it
+        bool lower = (m_lower.size() != 0) ? !Compare()(m_values[m_lower.top()], sample)
+                                           : (m_upper.size() == 0 || !Compare()(m_values[m_upper.top()], sample));
+        if (lower) {
+            m_in_lower[slot] = true;
+            m_lower.push(slot, m_values, m_positions);
+        } else {
+            m_in_lower[slot] = false;
+            m_upper.push(slot, m_values, m_positions);
+        }
+
+        // The lower half holds the extra sample of an odd count
+        while (m_lower.size() > m_upper.size() + 1) {
+            index_type moved = m_lower.pop(m_values, m_positions);
+            m_in_lower[moved] = false;
+            m_upper.push(moved, m_values, m_positions);
+        }
+        while (m_upper.size() > m_lower.size()) {
+            index_type moved = m_upper.pop(m_values, m_positions);
+            m_in_lower[moved] = true;
+            m_lower.push(moved, m_values, m_positions);
+        }
+    }
+
+    // The median; for an even count, the lower of the two middle samples
+    const_reference median() const {
+        ESTL_ASSERT(m_count > 0);
+        return m_values[m_lower.top()];
+    }
+
+    // The upper of the two middle samples for an even count, else median()
+    const_reference upper_median() const {
+        ESTL_ASSERT(m_count > 0);
+        return (m_upper.size() == m_lower.size()) ? m_values[m_upper.top()] : m_values[m_lower.top()];
+    }
+
+    // Capacity
+    size_type size() const {
+        return m_count;
+    }
+
+    bool empty() const {
+        return m_count == 0;
+    }
+
+    bool full() const {
+        return m_count == Window;
+    }
+
+    static constexpr size_type window() {
+        return Window;
+    }
+
+    // Modifiers
+    void clear() {
+        m_lower.clear();
+        m_upper.clear();
+        m_count = 0;
+        m_oldest = 0;
+    }
+
+private:
+    T m_values[Window];
+    index_type m_positions[Window];
+    bool m_in_lower[Window];
+    lower_heap m_lower;
+    upper_heap m_upper;
+    size_type m_count;
+    index_type m_oldest;
+};
+
+} // namespace estl
+
+#endif // ESTL_SLIDING_MEDIAN_HPP
@@ -0,0 +1,39 @@
+#ifndef ESTL_SMALL_VECTOR_HPP
+#define ESTL_SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include "config.hpp"
+#include "memory.hpp"
+#include "overflow.hpp"
+#include "pool.hpp"
+#include "vector.hpp"
+
+namespace estl {
+
+/**
+ * @brief A vector holding InlineN elements inline and up to Capacity in all
+ *
+ * An estl::vector on small_storage: each instance reserves only InlineN
+ * elements, and one that grows past them moves into a block of Capacity
+ * elements from Allocator until it is cleared. Without ESTL_USE_DYNAMIC_MEMORY
+ * the default allocator provides nothing, so pass an arena to spill into:
+ *
+ *   estl::pool<1024, 4> g_frames;
+ *   using frame_arena = estl::pool_allocator<decltype(g_frames), g_frames>;
+ *   estl::small_vector<uint8_t, 4, 1024, frame_arena> payload;
+ *
+ * Define ESTL_SPILL_HOOK to record which instances spill.
+ *
+ * @tparam T The type of elements
+ * @tparam InlineN The number of elements stored inline
+ * @tparam Capacity The maximum number of elements
+ * @tparam Allocator Where elements beyond InlineN live
+ * @tparam Overflow What insertions into a full vector do (see overflow_assert)
+ */
+template <typename T, size_t InlineN, size_t Capacity, typename Allocator = default_allocator,
+          typename Overflow = overflow_assert>
+using small_vector = vector<T, Capacity, small_storage<InlineN, Allocator>, Overflow>;
+
+} // namespace estl
+
+#endif // ESTL_SMALL_VECTOR_HPP
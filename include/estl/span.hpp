@@ -0,0 +1,279 @@
+#ifndef ESTL_SPAN_HPP
+#define ESTL_SPAN_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+
+namespace estl {
+
+// Extent of a span whose size is only known at run time
+constexpr size_t dynamic_extent = static_cast<size_t>(-1);
+
+template <typename T, size_t Extent = dynamic_extent>
+class span;
+
+namespace detail {
+
+// A fixed extent is part of the type and this base is empty, so the span
+// is a single pointer
+template <size_t Extent>
+struct span_extent {
+    constexpr explicit span_extent(size_t) {}
+
+    constexpr size_t size() const {
+        return Extent;
+    }
+};
+
+template <>
+struct span_extent<dynamic_extent> {
+    constexpr explicit span_extent(size_t size) : m_size(size) {}
+
+    constexpr size_t size() const {
+        return m_size;
+    }
+
+    size_t m_size;
+};
+
+template <typename T>
+struct is_span : std::false_type {};
+
+template <typename T, size_t Extent>
+struct is_span<span<T, Extent>> : std::true_type {};
+
+// Only qualification conversions (T to const T), never derived to base
+template <typename From, typename To>
+struct is_span_element_convertible : std::is_convertible<From (*)[], To (*)[]> {};
+
+// Contiguous containers exposing data() and size(), e.g. estl::vector
+template <typename Container, typename T, typename = void>
+struct is_span_container : std::false_type {};
+
+// Both members are probed here, where a missing one is a substitution failure
+// rather than a hard error
+template <typename Container, typename T>
+struct is_span_container<Container, T,
+                         decltype((void)std::declval<Container&>().size(), (void)std::declval<Container&>().data())>
+    : std::integral_constant<bool, !is_span<typename std::remove_cv<Container>::type>::value &&
+          is_span_element_convertible<
+              typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type, T>::value> {};
+
+// Extent of subspan<Offset, Count>()
+constexpr size_t subspan_extent(size_t extent, size_t offset, size_t count) {
+    return (count != dynamic_extent) ? count : (extent != dynamic_extent) ? extent - offset : dynamic_extent;
+}
+
+} // namespace detail
+
+/**
+ * @brief A non-owning view of a contiguous sequence of elements
+ *
+ * Like std::span: hands a slice of a vector, an array or a received frame to
+ * a helper as a pointer and a size, without copying it. A fixed Extent
+ * carries the size in the type, so the span is a single pointer, size() is a
+ * constant and first<N>()/subspan<Offset, N>() are bounds checked at compile
+ * time; loops over it have a known trip count.
+ *
+ * The viewed elements must outlive the span.
+ *
+ * @tparam T The element type, const for a read-only view
+ * @tparam Extent The number of elements, or dynamic_extent
+ */
+template <typename T, size_t Extent>
+class span : private detail::span_extent<Extent> {
+    using extent_base = detail::span_extent<Extent>;
+
+public:
+    // Type definitions
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = pointer;
+    using reverse_iterator = estl::reverse_iterator<iterator>;
+
+    static constexpr size_type extent = Extent;
+
+    // Constructors
+    template <size_t E = Extent, typename = typename std::enable_if<E == 0 || E == dynamic_extent>::type>
+    constexpr span() : extent_base(0), m_data(nullptr) {}
+
+    // count must equal Extent for a fixed-extent span
+    span(pointer data, size_type count) : extent_base(count), m_data(data) {
+        ESTL_ASSERT(Extent == dynamic_extent || count == Extent);
+    }
+
+    // A template, so span(p, 0) still picks the count constructor
+    template <typename Pointer, typename = typename std::enable_if<std::is_convertible<Pointer, pointer>::value>::type>
+    span(Pointer first, Pointer last) : span(first, static_cast<size_type>(last - first)) {}
+
+    template <size_t N, typename = typename std::enable_if<Extent == dynamic_extent || Extent == N>::type>
+    constexpr span(element_type (&array)[N]) : extent_base(N), m_data(array) {}
+
+    // Views the elements of a container such as estl::vector; dynamic
+    // extent only, as the size is a run-time value
+    template <typename Container, typename = typename std::enable_if<
+                  Extent == dynamic_extent && detail::is_span_container<Container, T>::value>::type>
+    constexpr span(Container& container) : extent_base(container.size()), m_data(container.data()) {}
+
+    // From a span of the same or non-const elements and a compatible extent
+    template <typename U, size_t N, typename = typename std::enable_if<
+                  (Extent == dynamic_extent || Extent == N) && detail::is_span_element_convertible<U, T>::value>::type>
+    constexpr span(const span<U, N>& other) : extent_base(other.size()), m_data(other.data()) {}
+
+    // Element access
+    reference operator[](size_type index) const {
+        ESTL_ASSERT(index < size());
+        return m_data[index];
+    }
+
+    reference front() const {
+        ESTL_ASSERT(!empty());
+        return m_data[0];
+    }
+
+    reference back() const {
+        ESTL_ASSERT(!empty());
+        return m_data[size() - 1];
+    }
+
+    constexpr pointer data() const {
+        return m_data;
+    }
+
+    // Iterators
+    constexpr iterator begin() const {
+        return m_data;
+    }
+
+    constexpr iterator end() const {
+        return m_data + size();
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    // Capacity
+    constexpr size_type size() const {
+        return extent_base::size();
+    }
+
+    constexpr size_type size_bytes() const {
+        return size() * sizeof(T);
+    }
+
+    constexpr bool empty() const {
+        return size() == 0;
+    }
+
+    // Subviews with the size known at compile time
+    template <size_t Count>
+    span<T, Count> first() const {
+        static_assert(Extent == dynamic_extent || Count <= Extent, "span::first beyond the extent");
+        ESTL_ASSERT(Count <= size());
+        return span<T, Count>(m_data, Count);
+    }
+
+    template <size_t Count>
+    span<T, Count> last() const {
+        static_assert(Extent == dynamic_extent || Count <= Extent, "span::last beyond the extent");
+        ESTL_ASSERT(Count <= size());
+        return span<T, Count>(m_data + (size() - Count), Count);
+    }
+
+    template <size_t Offset, size_t Count = dynamic_extent>
+    span<T, detail::subspan_extent(Extent, Offset, Count)> subspan() const {
+        static_assert(Extent == dynamic_extent || Offset <= Extent, "span::subspan offset beyond the extent");
+        static_assert(Extent == dynamic_extent || Count == dynamic_extent || Count <= Extent - Offset,
+                      "span::subspan beyond the extent");
+        ESTL_ASSERT(Offset <= size() && (Count == dynamic_extent || Count <= size() - Offset));
+        return span<T, detail::subspan_extent(Extent, Offset, Count)>(
+            m_data + Offset, (Count == dynamic_extent) ? size() - Offset : Count);
+    }
+
+    // Subviews with a run-time size
+    span<T> first(size_type count) const {
+        ESTL_ASSERT(count <= size());
+        return span<T>(m_data, count);
+    }
+
+    span<T> last(size_type count) const {
+        ESTL_ASSERT(count <= size());
+        return span<T>(m_data + (size() - count), count);
+    }
+
+    span<T> subspan(size_type offset, size_type count = dynamic_extent) const {
+        ESTL_ASSERT(offset <= size() && (count == dynamic_extent || count <= size() - offset));
+        return span<T>(m_data + offset, (count == dynamic_extent) ? size() - offset : count);
+    }
+
+private:
+    pointer m_data;
+};
+
+template <typename T, size_t Extent>
+constexpr size_t span<T, Extent>::extent;
+
+// Byte views, e.g. to checksum or transmit a struct array
+template <typename T, size_t Extent>
+span<const unsigned char, (Extent == dynamic_extent) ? dynamic_extent : Extent * sizeof(T)>
+as_bytes(span<T, Extent> s) {
+    return span<const unsigned char, (Extent == dynamic_extent) ? dynamic_extent : Extent * sizeof(T)>(
+        reinterpret_cast<const unsigned char*>(s.data()), s.size_bytes());
+}
+
+template <typename T, size_t Extent, typename = typename std::enable_if<!std::is_const<T>::value>::type>
+span<unsigned char, (Extent == dynamic_extent) ? dynamic_extent : Extent * sizeof(T)>
+as_writable_bytes(span<T, Extent> s) {
+    return span<unsigned char, (Extent == dynamic_extent) ? dynamic_extent : Extent * sizeof(T)>(
+        reinterpret_cast<unsigned char*>(s.data()), s.size_bytes());
+}
+
+// Algorithm overloads taking a span for the range
+template <typename T, size_t Extent, typename U>
+T* find(span<T, Extent> range, const U& value) {
+    return estl::find(range.begin(), range.end(), value);
+}
+
+template <typename T, size_t Extent, typename OutputIt>
+OutputIt copy(span<T, Extent> range, OutputIt d_first) {
+    return estl::copy(range.begin(), range.end(), d_first);
+}
+
+template <typename T, size_t Extent, typename U>
+T* lower_bound(span<T, Extent> range, const U& value) {
+    return estl::lower_bound(range.begin(), range.end(), value);
+}
+
+template <typename T, size_t Extent, typename U, typename Compare>
+T* lower_bound(span<T, Extent> range, const U& value, Compare comp) {
+    return estl::lower_bound(range.begin(), range.end(), value, comp);
+}
+
+template <typename T, size_t Extent>
+void sort(span<T, Extent> range) {
+    estl::sort(range.begin(), range.end());
+}
+
+template <typename T, size_t Extent, typename Compare>
+void sort(span<T, Extent> range, Compare comp) {
+    estl::sort(range.begin(), range.end(), comp);
+}
+
+} // namespace estl
+
+#endif // ESTL_SPAN_HPP
@@ -0,0 +1,266 @@
+#ifndef ESTL_SPSC_RING_HPP
+#define ESTL_SPSC_RING_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+#include "atomic.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Storage and indices for spsc_ring. head and tail are free-running counters
+// in the smallest type that holds Capacity; they only ever wrap modulo a
+// multiple of Capacity, so head - tail is always the element count.
+template <typename T, size_t Capacity>
+struct ring_buffer_base {
+    using index_type = typename capacity_size_type<Capacity>::type;
+
+    static constexpr size_t line_align = (ESTL_CACHE_LINE_SIZE > alignof(atomic_value<index_type>))
+        ? ESTL_CACHE_LINE_SIZE : alignof(atomic_value<index_type>);
+
+    constexpr ring_buffer_base() : m_storage(), m_head(), m_tail() {}
+
+    T* elements() {
+        return reinterpret_cast<T*>(m_storage.m_bytes);
+    }
+
+    const T* elements() const {
+        return reinterpret_cast<const T*>(m_storage.m_bytes);
+    }
+
+    inline_storage<T, Capacity> m_storage;
+    // Written by the producer only
+    alignas(line_align) atomic_value<index_type> m_head;
+    // Written by the consumer only
+    alignas(line_align) atomic_value<index_type> m_tail;
+};
+
+template <typename T, size_t Capacity>
+constexpr size_t ring_buffer_base<T, Capacity>::line_align;
+
+template <typename T, size_t Capacity, bool = std::is_trivially_destructible<T>::value>
+struct ring_buffer : ring_buffer_base<T, Capacity> {
+    constexpr ring_buffer() : ring_buffer_base<T, Capacity>() {}
+};
+
+template <typename T, size_t Capacity>
+struct ring_buffer<T, Capacity, false> : ring_buffer_base<T, Capacity> {
+    constexpr ring_buffer() : ring_buffer_base<T, Capacity>() {}
+
+    ~ring_buffer() {
+        using index_type = typename ring_buffer_base<T, Capacity>::index_type;
+        index_type head = this->m_head.load_relaxed();
+        for (index_type tail = this->m_tail.load_relaxed(); tail != head; ++tail) {
+            this->elements()[tail & (Capacity - 1)].~T();
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A lock-free single-producer/single-consumer ring buffer
+ *
+ * Intended for handing data from an interrupt to a task (or between two
+ * cores): one context only pushes, the other only pops, and neither needs a
+ * critical section. The producer publishes elements with a release store of
+ * the head index and the consumer frees slots with a release store of the
+ * tail index; head and tail sit on separate cache lines.
+ *
+ * For trivially copyable T the acquire_write/commit_write and
+ * acquire_read/commit_read pairs expose the free and filled slots as
+ * contiguous regions, so a DMA engine can write into or read from the ring
+ * directly.
+ *
+ * @tparam T The type of elements
+ * @tparam Capacity The maximum number of elements, must be a power of two
+ */
+template <typename T, size_t Capacity>
+class spsc_ring : private detail::ring_buffer<T, Capacity> {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "spsc_ring Capacity must be a power of two");
+
+    using storage_base = detail::ring_buffer<T, Capacity>;
+    using index_type = typename storage_base::index_type;
+    using storage_base::elements;
+    using storage_base::m_head;
+    using storage_base::m_tail;
+
+public:
+    // Type definitions
+    using value_type = T;
+    using size_type = size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    // Constructors
+    constexpr spsc_ring() : storage_base() {}
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    // Capacity - exact when called from either side while the other is idle,
+    // a snapshot otherwise
+    bool empty() const {
+        return size() == 0;
+    }
+
+    bool full() const {
+        return size() == Capacity;
+    }
+
+    size_type size() const {
+        return static_cast<index_type>(m_head.load_acquire() - m_tail.load_acquire());
+    }
+
+    size_type capacity() const {
+        return Capacity;
+    }
+
+    // Producer side
+    bool push(const T& value) {
+        return emplace(value);
+    }
+
+    bool push(T&& value) {
+        return emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        index_type head = m_head.load_relaxed();
+        if (static_cast<index_type>(head - m_tail.load_acquire()) == Capacity) {
+            return false;
+        }
+        new (&elements()[head & mask]) T(std::forward<Args>(args)...);
+        m_head.store_release(static_cast<index_type>(head + 1));
+        return true;
+    }
+
+    /**
+     * @brief Copies up to count elements into the ring
+     *
+     * @return The number of elements pushed, less than count if the ring fills
+     */
+    size_type push(const T* data, size_type count) {
+        index_type head = m_head.load_relaxed();
+        size_type free = Capacity - static_cast<index_type>(head - m_tail.load_acquire());
+        count = (count < free) ? count : free;
+
+        // At most two contiguous chunks: up to the end of storage, then from the start
+        size_type index = head & mask;
+        size_type first = (count < Capacity - index) ? count : Capacity - index;
+        uninitialized_copy(data, data + first, elements() + index);
+        uninitialized_copy(data + first, data + count, elements());
+
+        m_head.store_release(static_cast<index_type>(head + count));
+        return count;
+    }
+
+    /**
+     * @brief Returns the contiguous free region starting at the head
+     *
+     * count receives the number of slots that can be written before the
+     * storage wraps or the ring fills. Fill them (e.g. by DMA), then publish
+     * them with commit_write. Only for trivially copyable T.
+     */
+    T* acquire_write(size_type& count) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "acquire_write requires a trivially copyable T");
+        index_type head = m_head.load_relaxed();
+        size_type free = Capacity - static_cast<index_type>(head - m_tail.load_acquire());
+        size_type index = head & mask;
+        count = (free < Capacity - index) ? free : Capacity - index;
+        return elements() + index;
+    }
+
+    void commit_write(size_type count) {
+        index_type head = m_head.load_relaxed();
+        ESTL_ASSERT(count <= Capacity - static_cast<index_type>(head - m_tail.load_acquire()));
+        m_head.store_release(static_cast<index_type>(head + count));
+    }
+
+    // Consumer side
+    bool pop(T& value) {
+        index_type tail = m_tail.load_relaxed();
+        if (tail == m_head.load_acquire()) {
+            return false;
+        }
+        T& slot = elements()[tail & mask];
+        value = std::move(slot);
+        slot.~T();
+        m_tail.store_release(static_cast<index_type>(tail + 1));
+        return true;
+    }
+
+    // Oldest element, or nullptr when empty. Stays valid until it is popped.
+    T* front() {
+        index_type tail = m_tail.load_relaxed();
+        if (tail == m_head.load_acquire()) {
+            return nullptr;
+        }
+        return &elements()[tail & mask];
+    }
+
+    /**
+     * @brief Moves up to count elements out of the ring
+     *
+     * @return The number of elements popped, less than count if the ring empties
+     */
+    size_type pop(T* data, size_type count) {
+        index_type tail = m_tail.load_relaxed();
+        size_type used = static_cast<index_type>(m_head.load_acquire() - tail);
+        count = (count < used) ? count : used;
+
+        size_type index = tail & mask;
+        size_type first = (count < Capacity - index) ? count : Capacity - index;
+        estl::move(elements() + index, elements() + index + first, data);
+        destroy(elements() + index, elements() + index + first);
+        estl::move(elements(), elements() + (count - first), data + first);
+        destroy(elements(), elements() + (count - first));
+
+        m_tail.store_release(static_cast<index_type>(tail + count));
+        return count;
+    }
+
+    /**
+     * @brief Returns the contiguous filled region starting at the tail
+     *
+     * count receives the number of elements readable before the storage
+     * wraps. Release them with commit_read once consumed. Only for trivially
+     * copyable T.
+     */
+    const T* acquire_read(size_type& count) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "acquire_read requires a trivially copyable T");
+        index_type tail = m_tail.load_relaxed();
+        size_type used = static_cast<index_type>(m_head.load_acquire() - tail);
+        size_type index = tail & mask;
+        count = (used < Capacity - index) ? used : Capacity - index;
+        return elements() + index;
+    }
+
+    void commit_read(size_type count) {
+        index_type tail = m_tail.load_relaxed();
+        ESTL_ASSERT(count <= static_cast<index_type>(m_head.load_acquire() - tail));
+        m_tail.store_release(static_cast<index_type>(tail + count));
+    }
+
+private:
+    static constexpr size_type mask = Capacity - 1;
+};
+
+template <typename T, size_t Capacity>
+constexpr typename spsc_ring<T, Capacity>::size_type spsc_ring<T, Capacity>::mask;
+
+} // namespace estl
+
+#endif // ESTL_SPSC_RING_HPP
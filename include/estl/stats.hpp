@@ -0,0 +1,163 @@
+#ifndef ESTL_STATS_HPP
+#define ESTL_STATS_HPP
+
+#include <cstddef>
+#include "config.hpp"
+#include "intrusive_list.hpp"
+
+namespace estl {
+
+/**
+ * @brief Usage counters of one container, reported by visit_statistics()
+ */
+struct container_statistics {
+    const void* container; // Address of the container
+    const char* kind;      // "vector", "map", ...
+    size_t capacity;
+    size_t high_water;
+    size_t inserts;
+    size_t erases;
+    size_t finds;
+    size_t moves;          // Elements shifted by insert and erase
+    size_t overflows;      // Insertions refused for lack of capacity
+};
+
+namespace detail {
+
+#if ESTL_ENABLE_STATS
+
+struct stats_tag {};
+
+class container_counters;
+
+// Every instrumented container links its counters in here
+template <typename = void>
+struct stats_registry {
+    static intrusive_list<container_counters, stats_tag> instances;
+};
+
+template <typename Unused>
+intrusive_list<container_counters, stats_tag> stats_registry<Unused>::instances;
+
+// Counters containers inherit when ESTL_ENABLE_STATS is set
+class container_counters : public intrusive_list_hook<stats_tag> {
+public:
+    container_counters(const void* container, const char* kind, size_t capacity)
+        : m_container(container), m_kind(kind), m_capacity(capacity),
+          m_high_water(0), m_inserts(0), m_erases(0), m_finds(0), m_moves(0), m_overflows(0) {
+        stats_registry<>::instances.push_back(*this);
+    }
+
+    container_counters(const container_counters&) = delete;
+
+    // Assigning a container keeps the target's identity and counters
+    container_counters& operator=(const container_counters&) {
+        return *this;
+    }
+
+    ~container_counters() {
+        unlink();
+    }
+
+    void record_size(size_t size) {
+        if (size > m_high_water) {
+            m_high_water = size;
+        }
+    }
+
+    void record_insert(size_t size, size_t moves) {
+        ++m_inserts;
+        m_moves += moves;
+        record_size(size);
+    }
+
+    void record_erase(size_t moves) {
+        ++m_erases;
+        m_moves += moves;
+    }
+
+    void record_find() const {
+        ++m_finds;
+    }
+
+    void record_overflow() {
+        ++m_overflows;
+    }
+
+    container_statistics statistics() const {
+        container_statistics stats;
+        stats.container = m_container;
+        stats.kind = m_kind;
+        stats.capacity = m_capacity;
+        stats.high_water = m_high_water;
+        stats.inserts = m_inserts;
+        stats.erases = m_erases;
+        stats.finds = m_finds;
+        stats.moves = m_moves;
+        stats.overflows = m_overflows;
+        return stats;
+    }
+
+private:
+    const void* m_container;
+    const char* m_kind;
+    size_t m_capacity;
+    size_t m_high_water;
+    size_t m_inserts;
+    size_t m_erases;
+    mutable size_t m_finds;
+    size_t m_moves;
+    size_t m_overflows;
+};
+
+#else
+
+// Without ESTL_ENABLE_STATS the counters are an empty base and every
+// record call compiles to nothing
+class container_counters {
+public:
+    constexpr container_counters(const void*, const char*, size_t) {}
+
+    void record_size(size_t) {}
+    void record_insert(size_t, size_t) {}
+    void record_erase(size_t) {}
+    void record_find() const {}
+    void record_overflow() {}
+};
+
+#endif
+
+using stats_base = container_counters;
+
+} // namespace detail
+
+/**
+ * @brief Calls visitor(const container_statistics&) for every live container
+ *
+ * Lists the instrumented containers (vector, map) when ESTL_ENABLE_STATS is
+ * set and does nothing otherwise, e.g. from a debug console command:
+ *
+ *   estl::visit_statistics([](const estl::container_statistics& s) {
+ *       uart_printf("%s %p %u/%u peak, %u overflows\n", s.kind, s.container,
+ *                   unsigned(s.high_water), unsigned(s.capacity), unsigned(s.overflows));
+ *   });
+ *
+ * Containers register on construction without synchronization, so create
+ * them before interrupts or other threads that construct containers run.
+ */
+template <typename Visitor>
+void visit_statistics(Visitor visitor) {
+#if ESTL_ENABLE_STATS
+    using list_type = intrusive_list<detail::container_counters, detail::stats_tag>;
+    const list_type& instances = detail::stats_registry<>::instances;
+    for (list_type::const_iterator it = instances.begin(); it != instances.end(); ++it) {
+        visitor(it->statistics());
+    }
+#else
+    (void)visitor;
+#endif
+}
+
+} // namespace estl
+
+#endif // ESTL_STATS_HPP
@@ -0,0 +1,281 @@
+#ifndef ESTL_STRING_VIEW_HPP
+#define ESTL_STRING_VIEW_HPP
+
+#include <cstddef>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "hash.hpp"
+
+namespace estl {
+
+namespace detail {
+
+#if ESTL_HAS_CONSTEXPR14
+
+template <typename CharT>
+constexpr size_t string_length(const CharT* str) {
+    size_t length = 0;
+    while (str[length] != CharT()) {
+        ++length;
+    }
+    return length;
+}
+
+#else
+
+template <typename CharT>
+constexpr size_t string_length(const CharT* str) {
+    return (*str == CharT()) ? 0 : 1 + string_length(str + 1);
+}
+
+#endif
+
+} // namespace detail
+
+/**
+ * @brief A non-owning view of a character sequence
+ *
+ * Like std::string_view, without std::char_traits: a pointer and a length
+ * into a string literal, a received frame or an estl::fixed_string, so
+ * tokens can be split off and compared without copying them. The text need
+ * not be null-terminated, and views made by substr() never are.
+ *
+ * Searches for a single character use estl::find (vectorized where
+ * available). Out-of-range positions are caught by ESTL_ASSERT instead of
+ * exceptions.
+ *
+ * @tparam CharT The character type
+ */
+template <typename CharT>
+class basic_string_view {
+public:
+    // Type definitions
+    using value_type = CharT;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = CharT*;
+    using const_pointer = const CharT*;
+    using reference = CharT&;
+    using const_reference = const CharT&;
+    using iterator = const_pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = estl::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Constructors
+    constexpr basic_string_view() : m_data(nullptr), m_size(0) {}
+
+    constexpr basic_string_view(const_pointer data, size_type size) : m_data(data), m_size(size) {}
+
+    // From a null-terminated string; the length of a literal is computed at
+    // compile time when the view is constexpr
+    constexpr basic_string_view(const_pointer str) : m_data(str), m_size(detail::string_length(str)) {}
+
+    // Element access
+    const_reference operator[](size_type pos) const {
+        ESTL_ASSERT(pos < m_size);
+        return m_data[pos];
+    }
+
+    const_reference front() const {
+        ESTL_ASSERT(m_size > 0);
+        return m_data[0];
+    }
+
+    const_reference back() const {
+        ESTL_ASSERT(m_size > 0);
+        return m_data[m_size - 1];
+    }
+
+    constexpr const_pointer data() const {
+        return m_data;
+    }
+
+    // Iterators
+    constexpr const_iterator begin() const {
+        return m_data;
+    }
+
+    constexpr const_iterator end() const {
+        return m_data + m_size;
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+    constexpr size_type size() const {
+        return m_size;
+    }
+
+    constexpr size_type length() const {
+        return m_size;
+    }
+
+    constexpr bool empty() const {
+        return m_size == 0;
+    }
+
+    // Modifiers
+    void remove_prefix(size_type count) {
+        ESTL_ASSERT(count <= m_size);
+        m_data += count;
+        m_size -= count;
+    }
+
+    void remove_suffix(size_type count) {
+        ESTL_ASSERT(count <= m_size);
+        m_size -= count;
+    }
+
+    void swap(basic_string_view& other) {
+        basic_string_view tmp = *this;
+        *this = other;
+        other = tmp;
+    }
+
+    // Operations
+    // At most count characters from pos, which must not be past the end
+    basic_string_view substr(size_type pos, size_type count = npos) const {
+        ESTL_ASSERT(pos <= m_size);
+        size_type rest = m_size - pos;
+        return basic_string_view(m_data + pos, (count < rest) ? count : rest);
+    }
+
+    int compare(basic_string_view other) const {
+        size_type common = (m_size < other.m_size) ? m_size : other.m_size;
+        for (size_type i = 0; i < common; ++i) {
+            if (m_data[i] != other.m_data[i]) {
+                return (m_data[i] < other.m_data[i]) ? -1 : 1;
+            }
+        }
+        return (m_size == other.m_size) ? 0 : (m_size < other.m_size) ? -1 : 1;
+    }
+
+    bool starts_with(basic_string_view prefix) const {
+        return m_size >= prefix.m_size && substr(0, prefix.m_size).compare(prefix) == 0;
+    }
+
+    bool starts_with(CharT ch) const {
+        return m_size > 0 && m_data[0] == ch;
+    }
+
+    bool ends_with(basic_string_view suffix) const {
+        return m_size >= suffix.m_size && substr(m_size - suffix.m_size).compare(suffix) == 0;
+    }
+
+    bool ends_with(CharT ch) const {
+        return m_size > 0 && m_data[m_size - 1] == ch;
+    }
+
+    // Searching; each returns npos when there is no match
+    size_type find(CharT ch, size_type pos = 0) const {
+        if (pos >= m_size) {
+            return npos;
+        }
+        const_pointer it = estl::find(m_data + pos, m_data + m_size, ch);
+        return (it == end()) ? npos : static_cast<size_type>(it - m_data);
+    }
+
+    size_type find(basic_string_view str, size_type pos = 0) const {
+        if (str.m_size > m_size) {
+            return npos;
+        }
+        if (str.m_size == 0) {
+            return (pos <= m_size) ? pos : npos;
+        }
+        // Candidates start with the first character of str
+        for (size_type last = m_size - str.m_size; pos <= last; ++pos) {
+            pos = find(str.m_data[0], pos);
+            if (pos == npos || pos > last) {
+                return npos;
+            }
+            if (substr(pos, str.m_size).compare(str) == 0) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    size_type rfind(CharT ch, size_type pos = npos) const {
+        size_type i = (pos < m_size) ? pos + 1 : m_size;
+        while (i > 0) {
+            --i;
+            if (m_data[i] == ch) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    size_type find_first_of(basic_string_view chars, size_type pos = 0) const {
+        for (; pos < m_size; ++pos) {
+            if (chars.find(m_data[pos]) != npos) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    size_type find_first_not_of(basic_string_view chars, size_type pos = 0) const {
+        for (; pos < m_size; ++pos) {
+            if (chars.find(m_data[pos]) == npos) {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    // Comparisons, also against literals and anything else convertible
+    friend bool operator==(basic_string_view lhs, basic_string_view rhs) {
+        return lhs.m_size == rhs.m_size && lhs.compare(rhs) == 0;
+    }
+
+    friend bool operator!=(basic_string_view lhs, basic_string_view rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(basic_string_view lhs, basic_string_view rhs) {
+        return lhs.compare(rhs) < 0;
+    }
+
+    friend bool operator<=(basic_string_view lhs, basic_string_view rhs) {
+        return lhs.compare(rhs) <= 0;
+    }
+
+    friend bool operator>(basic_string_view lhs, basic_string_view rhs) {
+        return lhs.compare(rhs) > 0;
+    }
+
+    friend bool operator>=(basic_string_view lhs, basic_string_view rhs) {
+        return lhs.compare(rhs) >= 0;
+    }
+
+private:
+    const_pointer m_data;
+    size_type m_size;
+};
+
+template <typename CharT>
+constexpr typename basic_string_view<CharT>::size_type basic_string_view<CharT>::npos;
+
+using string_view = basic_string_view<char>;
+
+template <typename CharT>
+struct hash<basic_string_view<CharT>> {
+    size_t operator()(basic_string_view<CharT> value) const {
+        return detail::hash_bytes(value.data(), value.size() * sizeof(CharT));
+    }
+};
+
+} // namespace estl
+
+#endif // ESTL_STRING_VIEW_HPP
@@ -0,0 +1,219 @@
+#ifndef ESTL_TIMER_WHEEL_HPP
+#define ESTL_TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "config.hpp"
+#include "intrusive_list.hpp"
+
+namespace estl {
+
+namespace detail {
+
+constexpr size_t wheel_log2(size_t n) {
+    return (n <= 1) ? 0 : 1 + wheel_log2(n >> 1);
+}
+
+} // namespace detail
+
+// Hook tag, so timers can also derive from intrusive_list_hook<>
+struct timer_wheel_tag {};
+
+/**
+ * @brief Base class of timers scheduled on a timer_wheel
+ *
+ * A timer is armed while it sits on the wheel or on an expired list not yet
+ * drained; cancelling it in either place means it does not fire.
+ */
+class timer_wheel_entry : public intrusive_list_hook<timer_wheel_tag> {
+public:
+    constexpr timer_wheel_entry() : m_expiry(0) {}
+
+    bool armed() const {
+        return is_linked();
+    }
+
+    // Absolute tick the timer fires on
+    uint32_t expiry() const {
+        return m_expiry;
+    }
+
+private:
+    uint32_t m_expiry;
+
+    template <size_t, size_t, typename>
+    friend class timer_wheel;
+};
+
+/**
+ * @brief Lock policy for a timer_wheel used from a single context
+ *
+ * Supply a type with static lock()/unlock() (e.g. masking interrupts) when
+ * timers are armed or cancelled in one context and ticked in another.
+ */
+struct null_lock {
+    static void lock() {}
+    static void unlock() {}
+};
+
+/**
+ * @brief Hierarchical timing wheel
+ *
+ * Level 0 has one slot per tick for the next Slots ticks; each level above
+ * covers Slots times the span of the one below. arm() and cancel() are O(1):
+ * a timer is linked into the slot its deadline falls in, or unlinked from
+ * wherever it is. tick() hands the current level 0 slot to the caller with
+ * one splice and, every Slots ticks, redistributes one slot of the level
+ * above (cascading). A timer cascades at most Levels - 1 times, so a tick
+ * is amortized O(1); no timer is ever scanned before it is due.
+ *
+ * Nothing is allocated: the timers carry their own links (see
+ * timer_wheel_entry) and the wheel is Slots * Levels list heads. Callbacks
+ * are not run by the wheel; tick() moves expired timers onto a list the
+ * caller drains, e.g. outside the tick interrupt.
+ *
+ * Delays must be below 2^31 ticks; delays beyond the wheel's span of
+ * Slots^Levels ticks are parked in the top level and cascade again until
+ * they are in range.
+ *
+ * @tparam Slots The number of slots per level, a power of two
+ * @tparam Levels The number of levels
+ * @tparam Lock Lock policy guarding each operation (see null_lock)
+ */
+template <size_t Slots, size_t Levels, typename Lock = null_lock>
+class timer_wheel {
+    static_assert(Slots >= 2 && (Slots & (Slots - 1)) == 0, "timer_wheel slot count must be a power of two");
+    static_assert(Levels >= 1, "timer_wheel needs at least one level");
+
+    static constexpr size_t slot_bits = detail::wheel_log2(Slots);
+    static_assert(slot_bits * (Levels - 1) < 32, "timer_wheel levels exceed the 32-bit tick range");
+
+public:
+    using tick_type = uint32_t;
+    using size_type = size_t;
+    using expired_list = intrusive_list<timer_wheel_entry, timer_wheel_tag>;
+
+    // Longest delay held without parking in the top level
+    static constexpr tick_type span = (slot_bits * Levels >= 32)
+        ? tick_type(0xFFFFFFFFu) : tick_type((1ull << (slot_bits * Levels)) - 1);
+
+    // Constructors
+    constexpr timer_wheel() : m_slots(), m_now(0) {}
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    // Current tick
+    tick_type now() const {
+        return m_now;
+    }
+
+    // Ticks left until entry fires
+    tick_type remaining(const timer_wheel_entry& entry) const {
+        return entry.m_expiry - m_now;
+    }
+
+    /**
+     * @brief Arms (or re-arms) a timer to fire delay ticks from now
+     *
+     * A delay of 0 fires on the next tick.
+     */
+    void arm(timer_wheel_entry& entry, tick_type delay) {
+        ESTL_ASSERT(delay < (tick_type(1) << 31));
+        // A single level has nowhere to park delays beyond its span
+        ESTL_ASSERT(Levels > 1 || delay <= span);
+        Lock::lock();
+        entry.unlink();
+        entry.m_expiry = m_now + (delay ? delay : 1);
+        place(entry);
+        Lock::unlock();
+    }
+
+    void cancel(timer_wheel_entry& entry) {
+        Lock::lock();
+        entry.unlink();
+        Lock::unlock();
+    }
+
+    /**
+     * @brief Advances the wheel by one tick
+     *
+     * Appends the timers due on the new tick to expired.
+     */
+    void tick(expired_list& expired) {
+        Lock::lock();
+        ++m_now;
+        size_type index = m_now & (Slots - 1);
+        if (index == 0) {
+            for (size_type level = 1; level < Levels; ++level) {
+                size_type slot = (m_now >> (slot_bits * level)) & (Slots - 1);
+                cascade(m_slots[level][slot]);
+                if (slot != 0) {
+                    break;
+                }
+            }
+        }
+        expired.splice(expired.end(), m_slots[0][index]);
+        Lock::unlock();
+    }
+
+    void advance(tick_type ticks, expired_list& expired) {
+        for (; ticks > 0; --ticks) {
+            tick(expired);
+        }
+    }
+
+    // Disarms all timers on the wheel
+    void clear() {
+        Lock::lock();
+        for (size_type level = 0; level < Levels; ++level) {
+            for (size_type slot = 0; slot < Slots; ++slot) {
+                m_slots[level][slot].clear();
+            }
+        }
+        Lock::unlock();
+    }
+
+private:
+    using slot_list = intrusive_list<timer_wheel_entry, timer_wheel_tag>;
+
+    // Links entry into the slot of the lowest level whose span holds its
+    // deadline; deadlines beyond the wheel go where it ends
+    void place(timer_wheel_entry& entry) {
+        tick_type delta = entry.m_expiry - m_now;
+        tick_type target = entry.m_expiry;
+        if (delta > span) {
+            delta = span;
+            target = m_now + span;
+        }
+        size_type level = 0;
+        while (level + 1 < Levels && delta >= (1ull << (slot_bits * (level + 1)))) {
+            ++level;
+        }
+        m_slots[level][(target >> (slot_bits * level)) & (Slots - 1)].push_back(entry);
+    }
+
+    // Re-places the timers of a slot whose span has been reached
+    void cascade(slot_list& slot) {
+        slot_list pending;
+        pending.splice(pending.end(), slot);
+        while (!pending.empty()) {
+            timer_wheel_entry& entry = pending.front();
+            pending.pop_front();
+            place(entry);
+        }
+    }
+
+    slot_list m_slots[Levels][Slots];
+    tick_type m_now;
+};
+
+template <size_t Slots, size_t Levels, typename Lock>
+constexpr size_t timer_wheel<Slots, Levels, Lock>::slot_bits;
+
+template <size_t Slots, size_t Levels, typename Lock>
+constexpr typename timer_wheel<Slots, Levels, Lock>::tick_type timer_wheel<Slots, Levels, Lock>::span;
+
+} // namespace estl
+
+#endif // ESTL_TIMER_WHEEL_HPP
@@ -0,0 +1,666 @@
+#ifndef ESTL_UNORDERED_MAP_HPP
+#define ESTL_UNORDERED_MAP_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "config.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+#include "hash.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// Slot storage for the open-addressing tables. m_dist[i] is 0 for an empty
+// slot, otherwise the probe distance of the element in slot i plus one.
+template <typename V, size_t Capacity, bool = std::is_trivially_destructible<V>::value>
+struct slot_buffer_base {
+    using dist_type = typename capacity_size_type<Capacity>::type;
+
+    constexpr slot_buffer_base() : m_storage(), m_dist(), m_size(0) {}
+
+    V* slots() {
+        return reinterpret_cast<V*>(m_storage.m_bytes);
+    }
+
+    const V* slots() const {
+        return reinterpret_cast<const V*>(m_storage.m_bytes);
+    }
+
+    inline_storage<V, Capacity> m_storage;
+    dist_type m_dist[Capacity];
+    typename capacity_size_type<Capacity>::type m_size;
+};
+
+template <typename V, size_t Capacity>
+struct slot_buffer_base<V, Capacity, false> : slot_buffer_base<V, Capacity, true> {
+    constexpr slot_buffer_base() : slot_buffer_base<V, Capacity, true>() {}
+
+    ~slot_buffer_base() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            if (this->m_dist[i] != 0) {
+                this->slots()[i].~V();
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A fixed-capacity hash map for embedded systems
+ *
+ * Open addressing with Robin Hood probing over inline storage: elements in a
+ * probe run are kept ordered by their home slot, so a lookup stops as soon as
+ * it reaches an element closer to home than the probe. Erase uses backward
+ * shift deletion, so there are no tombstones and the table never degrades.
+ *
+ * All Capacity slots can be used, but probe lengths grow quickly above ~90%
+ * load; size Capacity with some headroom for the expected element count.
+ *
+ * @tparam Key The type of keys
+ * @tparam T The type of mapped values
+ * @tparam Hash The hash function object type
+ * @tparam KeyEqual The key equality function object type
+ * @tparam Capacity The number of slots, must be a power of two
+ */
+template <
+    typename Key,
+    typename T,
+    typename Hash = hash<Key>,
+    typename KeyEqual = equal_to<Key>,
+    size_t Capacity = 16
+>
+class unordered_map : private detail::slot_buffer_base<std::pair<const Key, T>, Capacity> {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "unordered_map Capacity must be a power of two");
+
+    using storage_base = detail::slot_buffer_base<std::pair<const Key, T>, Capacity>;
+    using dist_type = typename storage_base::dist_type;
+    using storage_base::slots;
+    using storage_base::m_dist;
+    using storage_base::m_size;
+
+public:
+    // Type definitions
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    // Iterators walk the slot array and skip empty slots
+    class iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = std::pair<const Key, T>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        iterator() : m_ptr(nullptr), m_index(0) {}
+        iterator(unordered_map* map_ptr, size_type index) : m_ptr(map_ptr), m_index(index) {}
+
+        reference operator*() const {
+            return m_ptr->slots()[m_index];
+        }
+
+        pointer operator->() const {
+            return &(m_ptr->slots()[m_index]);
+        }
+
+        iterator& operator++() {
+            m_index = m_ptr->next_occupied(m_index + 1);
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        iterator& operator--() {
+            m_index = m_ptr->prev_occupied(m_index);
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return m_ptr == other.m_ptr && m_index == other.m_index;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        unordered_map* m_ptr;
+        size_type m_index;
+
+        friend class unordered_map;
+        friend class const_iterator;
+    };
+
+    class const_iterator {
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = const std::pair<const Key, T>;
+        using difference_type = ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() : m_ptr(nullptr), m_index(0) {}
+        const_iterator(const unordered_map* map_ptr, size_type index) : m_ptr(map_ptr), m_index(index) {}
+        const_iterator(const iterator& it) : m_ptr(it.m_ptr), m_index(it.m_index) {}
+
+        reference operator*() const {
+            return m_ptr->slots()[m_index];
+        }
+
+        pointer operator->() const {
+            return &(m_ptr->slots()[m_index]);
+        }
+
+        const_iterator& operator++() {
+            m_index = m_ptr->next_occupied(m_index + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator& operator--() {
+            m_index = m_ptr->prev_occupied(m_index);
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_ptr == other.m_ptr && m_index == other.m_index;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const unordered_map* m_ptr;
+        size_type m_index;
+
+        friend class unordered_map;
+    };
+
+    // Constructors
+    constexpr unordered_map() : storage_base() {}
+
+    unordered_map(std::initializer_list<value_type> init) : storage_base() {
+        for (const value_type& value : init) {
+            insert(value);
+        }
+    }
+
+    // Same hash function and capacity, so every element keeps its slot
+    unordered_map(const unordered_map& other) : storage_base() {
+        copy_slots(other);
+    }
+
+    unordered_map(unordered_map&& other) : storage_base() {
+        move_slots(other);
+    }
+
+    // Assignment operators
+    unordered_map& operator=(const unordered_map& other) {
+        if (this != &other) {
+            clear();
+            copy_slots(other);
+        }
+        return *this;
+    }
+
+    unordered_map& operator=(unordered_map&& other) {
+        if (this != &other) {
+            clear();
+            move_slots(other);
+        }
+        return *this;
+    }
+
+    // Element access
+    T& at(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) {
+            ESTL_ASSERT(it != end());
+        }
+        return it->second;
+    }
+
+    const T& at(const Key& key) const {
+        const_iterator it = find(key);
+        if (it == end()) {
+            ESTL_ASSERT(it != end());
+        }
+        return it->second;
+    }
+
+    T& operator[](const Key& key) {
+        size_type index;
+        dist_type dist;
+        if (probe(key, index, dist)) {
+            return slots()[index].second;
+        }
+
+        if (m_size >= Capacity) {
+            // A new key needs room, asserted like the key of at(); insert
+            // reports a full table instead
+            ESTL_ASSERT(m_size < Capacity);
+            return end()->second;
+        }
+
+        // Insert a default value at the slot the probe stopped at
+        return construct_at(index, dist, key, T()).second;
+    }
+
+    // Iterators
+    iterator begin() {
+        return iterator(this, next_occupied(0));
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, next_occupied(0));
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    iterator end() {
+        return iterator(this, Capacity);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, Capacity);
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    // Capacity
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    size_type max_size() const {
+        return Capacity;
+    }
+
+    size_type bucket_count() const {
+        return Capacity;
+    }
+
+    float load_factor() const {
+        return static_cast<float>(m_size) / static_cast<float>(Capacity);
+    }
+
+    // Modifiers
+    void clear() {
+        for (size_type i = 0; i < Capacity; ++i) {
+            if (m_dist[i] != 0) {
+                slots()[i].~value_type();
+                m_dist[i] = 0;
+            }
+        }
+        m_size = 0;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        // A single probe gives both the duplicate check and the insert slot
+        size_type index;
+        dist_type dist;
+        if (probe(value.first, index, dist)) {
+            return std::make_pair(iterator(this, index), false);
+        }
+
+        // Check if we have capacity
+        if (m_size >= Capacity) {
+            // Handle capacity exceeded
+            ESTL_ASSERT(m_size < Capacity);
+            return std::make_pair(end(), false);
+        }
+
+        construct_at(index, dist, value);
+        return std::make_pair(iterator(this, index), true);
+    }
+
+    /**
+     * @brief Erases the element at pos and returns the following element
+     *
+     * Not for erasing while iterating over the whole table: backward shift
+     * may move an element from slot 0 into the last slot when a probe run
+     * wraps around, so such a loop can visit that element a second time.
+     * Use erase_if to erase the elements matching a predicate.
+     */
+    iterator erase(const_iterator pos) {
+        size_type index = pos.m_index;
+        erase_slot(index);
+
+        // The slot now holds the next element of the run, unless it wrapped
+        // around from slot 0, which iteration has already visited
+        if (index == Capacity - 1) {
+            return end();
+        }
+        return iterator(this, next_occupied(index));
+    }
+
+    size_type erase(const Key& key) {
+        size_type index;
+        dist_type dist;
+        if (!probe(key, index, dist)) {
+            return 0;
+        }
+
+        erase_slot(index);
+        return 1;
+    }
+
+    /**
+     * @brief Erases every element for which pred returns true
+     *
+     * Visits each element once, in slot order from a slot where no shift
+     * can cross: an empty one, or in a full table an element at its home
+     * slot. Backward shift then only ever moves elements not yet visited.
+     *
+     * @return The number of elements erased
+     */
+    template <typename Pred>
+    size_type erase_if(Pred pred) {
+        size_type erased = 0;
+        size_type start = empty_or_home_slot();
+        if (m_dist[start] != 0 && pred(slots()[start])) {
+            // No element was kept yet, so the freed slot may become the start
+            erase_slot(start);
+            ++erased;
+            start = empty_or_home_slot();
+        }
+        for (size_type step = 1; step < Capacity;) {
+            size_type index = (start + step) & mask;
+            if (m_dist[index] != 0 && pred(slots()[index])) {
+                // The slot now holds the next element of the run, if any
+                erase_slot(index);
+                ++erased;
+            } else {
+                ++step;
+            }
+        }
+        return erased;
+    }
+
+    void swap(unordered_map& other) {
+        // Both tables hash identically, so slots can be exchanged pairwise
+        for (size_type i = 0; i < Capacity; ++i) {
+            if (m_dist[i] != 0 && other.m_dist[i] != 0) {
+                value_type temp(std::move(slots()[i]));
+                slots()[i].~value_type();
+                new (&slots()[i]) value_type(std::move(other.slots()[i]));
+                other.slots()[i].~value_type();
+                new (&other.slots()[i]) value_type(std::move(temp));
+            } else if (m_dist[i] != 0) {
+                new (&other.slots()[i]) value_type(std::move(slots()[i]));
+                slots()[i].~value_type();
+            } else if (other.m_dist[i] != 0) {
+                new (&slots()[i]) value_type(std::move(other.slots()[i]));
+                other.slots()[i].~value_type();
+            }
+
+            dist_type temp_dist = m_dist[i];
+            m_dist[i] = other.m_dist[i];
+            other.m_dist[i] = temp_dist;
+        }
+
+        // Swap sizes
+        size_type temp_size = m_size;
+        m_size = other.m_size;
+        other.m_size = temp_size;
+    }
+
+    // Lookup
+    size_type count(const Key& key) const {
+        size_type index;
+        dist_type dist;
+        return probe(key, index, dist) ? 1 : 0;
+    }
+
+    iterator find(const Key& key) {
+        size_type index;
+        dist_type dist;
+        return probe(key, index, dist) ? iterator(this, index) : end();
+    }
+
+    const_iterator find(const Key& key) const {
+        size_type index;
+        dist_type dist;
+        return probe(key, index, dist) ? const_iterator(this, index) : end();
+    }
+
+    // Observers
+    hasher hash_function() const {
+        return Hash();
+    }
+
+    key_equal key_eq() const {
+        return KeyEqual();
+    }
+
+private:
+    static constexpr size_type mask = Capacity - 1;
+
+    static constexpr unsigned log2(size_type n) {
+        return (n <= 1) ? 0 : 1 + log2(n >> 1);
+    }
+
+    // Fibonacci hashing: the top bits of hash * 2^N/phi spread keys with
+    // low-entropy hashes (sequential IDs, aligned pointers) across the table
+    static size_type home_slot(const Key& key) {
+        const unsigned bits = sizeof(size_t) * 8;
+        const size_t golden = (sizeof(size_t) >= 8)
+            ? static_cast<size_t>(0x9E3779B97F4A7C15ull)
+            : static_cast<size_t>(0x9E3779B9u);
+        if (Capacity == 1) {
+            return 0;
+        }
+        return (Hash()(key) * golden) >> ((bits - log2(Capacity)) % bits);
+    }
+
+    /**
+     * Looks up key. On success index is the element's slot. Otherwise index
+     * and dist describe where key would be inserted: the first slot whose
+     * resident is closer to home than the probe (or an empty slot).
+     */
+    bool probe(const Key& key, size_type& index, dist_type& dist) const {
+        index = home_slot(key);
+        dist = 1;
+        for (;;) {
+            if (m_dist[index] < dist) {
+                return false;
+            }
+            if (m_dist[index] == dist && KeyEqual()(slots()[index].first, key)) {
+                return true;
+            }
+            index = (index + 1) & mask;
+            if (dist == Capacity) {
+                return false;
+            }
+            ++dist;
+        }
+    }
+
+    // Places a new element at index with probe distance dist, shifting the
+    // rest of the run one slot further from home to keep it ordered
+    template <typename... Args>
+    value_type& construct_at(size_type index, dist_type dist, Args&&... args) {
+        if (m_dist[index] != 0) {
+            size_type last = index;
+            while (m_dist[last] != 0) {
+                last = (last + 1) & mask;
+            }
+            while (last != index) {
+                size_type prev = (last - 1) & mask;
+                new (&slots()[last]) value_type(std::move(slots()[prev]));
+                slots()[prev].~value_type();
+                m_dist[last] = static_cast<dist_type>(m_dist[prev] + 1);
+                last = prev;
+            }
+        }
+
+        new (&slots()[index]) value_type(std::forward<Args>(args)...);
+        m_dist[index] = dist;
+        ++m_size;
+        return slots()[index];
+    }
+
+    // Backward shift deletion: pull the following elements of the run one
+    // slot closer to home until an empty slot or a home slot is reached
+    void erase_slot(size_type index) {
+        slots()[index].~value_type();
+
+        size_type next = (index + 1) & mask;
+        while (m_dist[next] > 1) {
+            new (&slots()[index]) value_type(std::move(slots()[next]));
+            slots()[next].~value_type();
+            m_dist[index] = static_cast<dist_type>(m_dist[next] - 1);
+            index = next;
+            next = (next + 1) & mask;
+        }
+
+        m_dist[index] = 0;
+        --m_size;
+    }
+
+    // An empty slot, else one whose element sits at its home slot, which
+    // backward shift never moves; a full table always has one
+    size_type empty_or_home_slot() const {
+        size_type home = 0;
+        for (size_type i = Capacity; i-- > 0;) {
+            if (m_dist[i] == 0) {
+                return i;
+            }
+            if (m_dist[i] == 1) {
+                home = i;
+            }
+        }
+        ESTL_ASSERT(m_dist[home] == 1);
+        return home;
+    }
+
+    size_type next_occupied(size_type index) const {
+        while (index < Capacity && m_dist[index] == 0) {
+            ++index;
+        }
+        return index;
+    }
+
+    size_type prev_occupied(size_type index) const {
+        do {
+            --index;
+        } while (m_dist[index] == 0);
+        return index;
+    }
+
+    void copy_slots(const unordered_map& other) {
+        for (size_type i = 0; i < Capacity; ++i) {
+            if (other.m_dist[i] != 0) {
+                new (&slots()[i]) value_type(other.slots()[i]);
+            }
+            m_dist[i] = other.m_dist[i];
+        }
+        m_size = other.m_size;
+    }
+
+    void move_slots(unordered_map& other) {
+        for (size_type i = 0; i < Capacity; ++i) {
+            if (other.m_dist[i] != 0) {
+                new (&slots()[i]) value_type(std::move(other.slots()[i]));
+            }
+            m_dist[i] = other.m_dist[i];
+        }
+        m_size = other.m_size;
+        other.clear();
+    }
+
+    // Make iterators friends to access private members
+    friend class iterator;
+    friend class const_iterator;
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, size_t Capacity>
+constexpr typename unordered_map<Key, T, Hash, KeyEqual, Capacity>::size_type
+    unordered_map<Key, T, Hash, KeyEqual, Capacity>::mask;
+
+// Non-member functions
+template <typename Key, typename T, typename Hash, typename KeyEqual, size_t Capacity>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Capacity>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Capacity>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    for (auto it = lhs.begin(); it != lhs.end(); ++it) {
+        auto found = rhs.find(it->first);
+        if (found == rhs.end() || !(found->second == it->second)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, size_t Capacity>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Capacity>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Capacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, size_t Capacity>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Capacity>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual, Capacity>& rhs) {
+    lhs.swap(rhs);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, size_t Capacity, typename Pred>
+typename unordered_map<Key, T, Hash, KeyEqual, Capacity>::size_type
+    erase_if(unordered_map<Key, T, Hash, KeyEqual, Capacity>& map, Pred pred) {
+    return map.erase_if(pred);
+}
+
+} // namespace estl
+
+#endif // ESTL_UNORDERED_MAP_HPP
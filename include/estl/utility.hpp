@@ -0,0 +1,26 @@
+#ifndef ESTL_UTILITY_HPP
+#define ESTL_UTILITY_HPP
+
+#include <cstddef>
+#include "config.hpp"
+
+namespace estl {
+
+namespace detail {
+
+// C++11 stand-in for std::index_sequence, to expand arrays element by
+// element in constexpr constructors
+template <size_t... I>
+struct index_sequence {};
+
+template <size_t N, size_t... I>
+struct make_index_sequence : make_index_sequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct make_index_sequence<0, I...> : index_sequence<I...> {};
+
+} // namespace detail
+
+} // namespace estl
+
+#endif // ESTL_UTILITY_HPP
@@ -3,8 +3,15 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "config.hpp"
 #include "iterator.hpp"
+#include "algorithm.hpp"
+#include "memory.hpp"
+#include "overflow.hpp"
+#include "stats.hpp"
 
 namespace estl {
 
@@ -17,9 +24,25 @@ namespace estl {
  * 
  * @tparam T The type of elements
  * @tparam Capacity The maximum number of elements (static allocation)
+ * @tparam Storage Where the elements live (static_storage, allocator_storage
+ *         or small_storage)
+ * @tparam Overflow What insertions into a full vector do (see overflow_assert)
  */
-template <typename T, size_t Capacity>
-class vector {
+template <typename T, size_t Capacity, typename Storage = static_storage, typename Overflow = overflow_assert>
+class vector : private Storage::template buffer<T, Capacity>, private detail::stats_base {
+    using storage_base = typename Storage::template buffer<T, Capacity>;
+    using stats_base = detail::stats_base;
+    using storage_base::elements;
+    using storage_base::acquire_storage;
+    using storage_base::release_storage;
+    using storage_base::swap_storage;
+    using storage_base::m_size;
+    using length_type = typename detail::capacity_size_type<Capacity>::type;
+    using stats_base::record_size;
+    using stats_base::record_insert;
+    using stats_base::record_erase;
+    using stats_base::record_overflow;
+
 public:
     // Type definitions
     using value_type = T;
@@ -35,21 +58,27 @@ public:
     using const_reverse_iterator = estl::reverse_iterator<const_iterator>;
 
     // Constructors
-    vector() : m_size(0) {}
+    constexpr vector() : storage_base(), stats_base(this, "vector", Capacity) {}
 
-    vector(size_type count, const T& value) : m_size(0) {
+    vector(size_type count, const T& value) : storage_base(), stats_base(this, "vector", Capacity) {
         assign(count, value);
     }
 
-    vector(std::initializer_list<T> init) : m_size(0) {
+    vector(std::initializer_list<T> init) : storage_base(), stats_base(this, "vector", Capacity) {
         assign(init);
     }
 
     // Copy constructor
-    vector(const vector& other) : m_size(0) {
+    vector(const vector& other) : storage_base(), stats_base(this, "vector", Capacity) {
         assign(other.begin(), other.end());
     }
 
+    // Move constructor - takes over the source's storage block if it has
+    // one, otherwise moves the elements one by one; the source is left empty
+    vector(vector&& other) : storage_base(), stats_base(this, "vector", Capacity) {
+        take_elements(other);
+    }
+
     // Assignment operators
     vector& operator=(const vector& other) {
         if (this != &other) {
@@ -58,6 +87,14 @@ public:
         return *this;
     }
 
+    vector& operator=(vector&& other) {
+        if (this != &other) {
+            clear();
+            take_elements(other);
+        }
+        return *this;
+    }
+
     vector& operator=(std::initializer_list<T> ilist) {
         assign(ilist);
         return *this;
@@ -70,71 +107,71 @@ public:
             // but for embedded systems, we might want to handle this differently
             ESTL_ASSERT(pos < m_size);
         }
-        return m_data[pos];
+        return elements()[pos];
     }
 
     const_reference at(size_type pos) const {
         if (pos >= m_size) {
             ESTL_ASSERT(pos < m_size);
         }
-        return m_data[pos];
+        return elements()[pos];
     }
 
     reference operator[](size_type pos) {
-        return m_data[pos];
+        return elements()[pos];
     }
 
     const_reference operator[](size_type pos) const {
-        return m_data[pos];
+        return elements()[pos];
     }
 
     reference front() {
-        return m_data[0];
+        return elements()[0];
     }
 
     const_reference front() const {
-        return m_data[0];
+        return elements()[0];
     }
 
     reference back() {
-        return m_data[m_size - 1];
+        return elements()[m_size - 1];
     }
 
     const_reference back() const {
-        return m_data[m_size - 1];
+        return elements()[m_size - 1];
     }
 
     T* data() {
-        return m_data;
+        return elements();
     }
 
     const T* data() const {
-        return m_data;
+        return elements();
     }
 
     // Iterators
     iterator begin() {
-        return m_data;
+        return elements();
     }
 
     const_iterator begin() const {
-        return m_data;
+        return elements();
     }
 
     const_iterator cbegin() const {
-        return m_data;
+        return elements();
     }
 
     iterator end() {
-        return m_data + m_size;
+        return elements() + m_size;
     }
 
     const_iterator end() const {
-        return m_data + m_size;
+        return elements() + m_size;
     }
 
     const_iterator cend() const {
-        return m_data + m_size;
+        return elements() + m_size;
     }
 
     reverse_iterator rbegin() {
@@ -180,48 +217,63 @@ public:
 
     // Modifiers
     void clear() {
-        for (size_type i = 0; i < m_size; ++i) {
-            m_data[i].~T();
-        }
+        destroy(elements(), elements() + m_size);
         m_size = 0;
+        release_storage();
     }
 
     iterator insert(const_iterator pos, const T& value) {
         size_type index = pos - begin();
-        if (m_size < Capacity) {
-            if (index < m_size) {
-                // Move elements to make space
-                for (size_type i = m_size; i > index; --i) {
-                    new (&m_data[i]) T(m_data[i - 1]);
-                    m_data[i - 1].~T();
-                }
-            }
+        if (room_relocates()) {
+            // Spilling moves the elements, and value may be one of them
+            T copy(value);
+            return insert(begin() + index, std::move(copy));
+        }
+        if (has_room()) {
+            // Move elements to make space
+            detail::relocate_up(elements(), index, m_size);
             // Insert new element
-            new (&m_data[index]) T(value);
+            new (&elements()[index]) T(value);
             ++m_size;
-        } else {
-            // Handle capacity exceeded - in embedded systems we might want to assert here
-            ESTL_ASSERT(m_size < Capacity);
+            record_insert(m_size, m_size - 1 - index);
+        } else if (!overflow_insert(index, value)) {
+            return end();
         }
         return begin() + index;
     }
 
     iterator insert(const_iterator pos, T&& value) {
         size_type index = pos - begin();
-        if (m_size < Capacity) {
-            if (index < m_size) {
-                // Move elements to make space
-                for (size_type i = m_size; i > index; --i) {
-                    new (&m_data[i]) T(std::move(m_data[i - 1]));
-                    m_data[i - 1].~T();
-                }
-            }
+        if (has_room()) {
+            // Move elements to make space
+            detail::relocate_up(elements(), index, m_size);
             // Insert new element
-            new (&m_data[index]) T(std::move(value));
+            new (&elements()[index]) T(std::move(value));
             ++m_size;
-        } else {
-            // Handle capacity exceeded
-            ESTL_ASSERT(m_size < Capacity);
+            record_insert(m_size, m_size - 1 - index);
+        } else if (!overflow_insert(index, std::move(value))) {
+            return end();
+        }
+        return begin() + index;
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        size_type index = pos - begin();
+        if (index != m_size || room_relocates()) {
+            // Build the value first, the arguments may refer to elements
+            // that are about to be shifted, or moved by a spill; pos itself
+            // is stale after a spill, so the index is used
+            T value(std::forward<Args>(args)...);
+            return insert(begin() + index, std::move(value));
+        }
+        if (has_room()) {
+            // Construct directly in the free slot at the end
+            new (&elements()[m_size]) T(std::forward<Args>(args)...);
+            ++m_size;
+            record_insert(m_size, 0);
+        } else if (!overflow_insert(index, std::forward<Args>(args)...)) {
+            return end();
         }
         return begin() + index;
     }
@@ -230,101 +282,145 @@ public:
         size_type index = pos - begin();
         if (index < m_size) {
             // Destroy the element at position
-            m_data[index].~T();
+            elements()[index].~T();
             
             // Move subsequent elements
-            for (size_type i = index; i < m_size - 1; ++i) {
-                new (&m_data[i]) T(std::move(m_data[i + 1]));
-                m_data[i + 1].~T();
-            }
+            detail::relocate_down(elements(), index, m_size);
             
             --m_size;
+            record_erase(m_size - index);
         }
         return begin() + index;
     }
 
     void push_back(const T& value) {
-        if (m_size < Capacity) {
-            new (&m_data[m_size]) T(value);
-            ++m_size;
+        size_type index;
+        if (room_relocates()) {
+            // Spilling moves the elements, and value may be one of them
+            T copy(value);
+            append(index, std::move(copy));
         } else {
-            // Handle capacity exceeded
-            ESTL_ASSERT(m_size < Capacity);
+            append(index, value);
         }
     }
 
     void push_back(T&& value) {
-        if (m_size < Capacity) {
-            new (&m_data[m_size]) T(std::move(value));
-            ++m_size;
+        size_type index;
+        append(index, std::move(value));
+    }
+
+    // Returns an iterator to the new element, or end() if the overflow
+    // policy dropped it
+    template <typename... Args>
+    iterator emplace_back(Args&&... args) {
+        size_type index;
+        bool stored;
+        if (room_relocates()) {
+            // Spilling moves the elements, which the arguments may refer to
+            T value(std::forward<Args>(args)...);
+            stored = append(index, std::move(value));
         } else {
-            // Handle capacity exceeded
-            ESTL_ASSERT(m_size < Capacity);
+            stored = append(index, std::forward<Args>(args)...);
+        }
+        return stored ? begin() + index : end();
+    }
+
+    /**
+     * @brief Constructs an element at the end if there is room
+     * 
+     * Non-asserting alternative to emplace_back for callers that handle a
+     * full vector themselves (e.g. dropping samples in an ISR). Never
+     * evicts, whatever the overflow policy.
+     * 
+     * @return true if the element was added, false if the vector is full
+     */
+    template <typename... Args>
+    bool try_emplace_back(Args&&... args) {
+        if (room_relocates()) {
+            T value(std::forward<Args>(args)...);
+            return try_append(std::move(value));
         }
+        return try_append(std::forward<Args>(args)...);
     }
 
     void pop_back() {
         if (m_size > 0) {
             --m_size;
-            m_data[m_size].~T();
+            elements()[m_size].~T();
+            record_erase(0);
         }
     }
 
     void resize(size_type count) {
         if (count > Capacity) {
+            record_overflow();
             count = Capacity;  // Limit to capacity
         }
         
+        if (count > m_size && !acquire_storage(count)) {
+            record_overflow();
+            return;
+        }
+        
         if (count > m_size) {
             // Construct new elements
             for (size_type i = m_size; i < count; ++i) {
-                new (&m_data[i]) T();
+                new (&elements()[i]) T();
             }
         } else if (count < m_size) {
             // Destroy excess elements
-            for (size_type i = count; i < m_size; ++i) {
-                m_data[i].~T();
-            }
+            destroy(elements() + count, elements() + m_size);
         }
         
-        m_size = count;
+        m_size = static_cast<length_type>(count);
+        record_size(m_size);
     }
 
     void resize(size_type count, const value_type& value) {
         if (count > Capacity) {
+            record_overflow();
             count = Capacity;  // Limit to capacity
         }
         
+        if (count > m_size && !acquire_storage(count)) {
+            record_overflow();
+            return;
+        }
+        
         if (count > m_size) {
             // Construct new elements with value
-            for (size_type i = m_size; i < count; ++i) {
-                new (&m_data[i]) T(value);
-            }
+            uninitialized_fill_n(elements() + m_size, count - m_size, value);
         } else if (count < m_size) {
             // Destroy excess elements
-            for (size_type i = count; i < m_size; ++i) {
-                m_data[i].~T();
-            }
+            destroy(elements() + count, elements() + m_size);
         }
         
-        m_size = count;
+        m_size = static_cast<length_type>(count);
+        record_size(m_size);
     }
 
     template <class InputIt>
     void assign(InputIt first, InputIt last) {
         clear();
-        while (first != last && m_size < Capacity) {
-            push_back(*first);
-            ++first;
-        }
+        assign_impl(first, last, std::is_pointer<InputIt>());
     }
 
     void assign(size_type count, const T& value) {
         clear();
-        count = (count <= Capacity) ? count : Capacity;
-        for (size_type i = 0; i < count; ++i) {
-            push_back(value);
+        if (count > Capacity) {
+            record_overflow();
+            count = Capacity;
+        }
+        if (count == 0) {
+            return;
+        }
+        if (!acquire_storage(count)) {
+            record_overflow();
+            return;
         }
+        uninitialized_fill_n(elements(), count, value);
+        m_size = static_cast<length_type>(count);
+        record_size(m_size);
     }
 
     void assign(std::initializer_list<T> ilist) {
@@ -332,48 +428,164 @@ public:
     }
 
     void swap(vector& other) {
-        // Since we can't swap the arrays directly (fixed size),
-        // we need to swap elements individually
+        // Allocator blocks change hands, so swapping never allocates
+        if (swap_storage(other)) {
+            record_size(m_size);
+            other.record_size(other.m_size);
+            return;
+        }
+
+        // Inline arrays can't be swapped directly (fixed size),
+        // so we need to swap elements individually
         size_type min_size = (m_size < other.m_size) ? m_size : other.m_size;
         
         // Swap common elements
         for (size_type i = 0; i < min_size; ++i) {
-            T temp = std::move(m_data[i]);
-            m_data[i] = std::move(other.m_data[i]);
-            other.m_data[i] = std::move(temp);
+            T temp = std::move(elements()[i]);
+            elements()[i] = std::move(other.elements()[i]);
+            other.elements()[i] = std::move(temp);
         }
         
         // Handle case where this vector is larger
         if (m_size > min_size) {
             for (size_type i = min_size; i < m_size; ++i) {
-                new (&other.m_data[i]) T(std::move(m_data[i]));
-                m_data[i].~T();
+                new (&other.elements()[i]) T(std::move(elements()[i]));
+                elements()[i].~T();
             }
         }
         // Handle case where other vector is larger
         else if (other.m_size > min_size) {
             for (size_type i = min_size; i < other.m_size; ++i) {
-                new (&m_data[i]) T(std::move(other.m_data[i]));
-                other.m_data[i].~T();
+                new (&elements()[i]) T(std::move(other.elements()[i]));
+                other.elements()[i].~T();
             }
         }
         
         // Swap sizes
         size_type temp_size = m_size;
         m_size = other.m_size;
-        other.m_size = temp_size;
+        other.m_size = static_cast<length_type>(temp_size);
+        record_size(m_size);
+        other.record_size(other.m_size);
     }
 
 private:
-    // Storage for elements - using aligned storage to allow for proper construction/destruction
-    alignas(T) unsigned char m_storage[sizeof(T) * Capacity];
-    T* m_data = reinterpret_cast<T*>(m_storage);
-    size_type m_size;
+    // Moves other's elements into this empty vector and empties other
+    void take_elements(vector& other) {
+        if (!swap_storage(other)) {
+            // Both inline, so there is room without acquiring storage
+            uninitialized_move(other.elements(), other.elements() + other.m_size, elements());
+            m_size = other.m_size;
+        }
+        record_size(m_size);
+        other.clear();
+    }
+
+    // True if one more element fits; allocator-backed vectors take their
+    // storage block on first use, small_storage ones when they outgrow the
+    // inline area
+    bool has_room() {
+        return m_size < Capacity && acquire_storage(m_size + 1u);
+    }
+
+    // True if has_room() would spill a small_storage vector, moving the
+    // elements to the heap block
+    bool room_relocates() const {
+        return m_size < Capacity && !storage_base::keeps_elements(m_size + 1u);
+    }
+
+    // Adds an element at the end, or as the overflow policy prescribes;
+    // index receives its slot. Returns false when it was dropped.
+    template <typename... Args>
+    bool append(size_type& index, Args&&... args) {
+        // Any evicting policy leaves the new element last
+        index = m_size;
+        if (has_room()) {
+            new (&elements()[m_size]) T(std::forward<Args>(args)...);
+            ++m_size;
+            record_insert(m_size, 0);
+            return true;
+        }
+        return overflow_insert(index, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    bool try_append(Args&&... args) {
+        if (!has_room()) {
+            record_overflow();
+            return false;
+        }
+        new (&elements()[m_size]) T(std::forward<Args>(args)...);
+        ++m_size;
+        record_insert(m_size, 0);
+        return true;
+    }
+
+    // Stores a new element at index in a vector with no room, as the
+    // overflow policy prescribes; index is updated to where it went.
+    // Returns false when the element was dropped.
+    template <typename... Args>
+    bool overflow_insert(size_type& index, Args&&... args) {
+        record_overflow();
+        Overflow::on_overflow();
+        return emplace_evicting(index, detail::overflow_tag<Overflow>(), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    bool emplace_evicting(size_type&, std::integral_constant<overflow_action, overflow_action::reject>, Args&&...) {
+        return false;
+    }
+
+    // The value is built first, the arguments may refer to the element
+    // about to be evicted
+    template <typename Action, typename... Args>
+    bool emplace_evicting(size_type& index, Action action, Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        size_type shifted = 0;
+        if (!detail::open_overflow_slot(elements(), m_size, index, shifted, action)) {
+            return false;
+        }
+        new (&elements()[index]) T(std::move(value));
+        record_erase(shifted);
+        record_insert(m_size, 0);
+        return true;
+    }
+
+    template <class InputIt>
+    void assign_impl(InputIt first, InputIt last, std::false_type) {
+        while (first != last && m_size < Capacity) {
+            push_back(*first);
+            ++first;
+        }
+        if (first != last) {
+            record_overflow();
+        }
+    }
+
+    // Pointer ranges are copied in one pass (memcpy for trivial types)
+    template <class Pointer>
+    void assign_impl(Pointer first, Pointer last, std::true_type) {
+        size_type count = static_cast<size_type>(last - first);
+        if (count > Capacity) {
+            record_overflow();
+            count = Capacity;
+        }
+        if (count == 0) {
+            return;
+        }
+        if (!acquire_storage(count)) {
+            record_overflow();
+            return;
+        }
+        uninitialized_copy(first, first + count, elements());
+        m_size = static_cast<length_type>(count);
+        record_size(m_size);
+    }
 };
 
 // Non-member functions
-template <typename T, size_t Capacity>
-bool operator==(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs) {
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+bool operator==(const vector<T, Capacity, Storage, Overflow>& lhs, const vector<T, Capacity, Storage, Overflow>& rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
@@ -387,33 +599,33 @@ bool operator==(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs)
     return true;
 }
 
-template <typename T, size_t Capacity>
-bool operator!=(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs) {
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+bool operator!=(const vector<T, Capacity, Storage, Overflow>& lhs, const vector<T, Capacity, Storage, Overflow>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename T, size_t Capacity>
-bool operator<(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+bool operator<(const vector<T, Capacity, Storage, Overflow>& lhs, const vector<T, Capacity, Storage, Overflow>& rhs) {
+    return estl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename T, size_t Capacity>
-bool operator<=(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs) {
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+bool operator<=(const vector<T, Capacity, Storage, Overflow>& lhs, const vector<T, Capacity, Storage, Overflow>& rhs) {
     return !(rhs < lhs);
 }
 
-template <typename T, size_t Capacity>
-bool operator>(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs) {
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+bool operator>(const vector<T, Capacity, Storage, Overflow>& lhs, const vector<T, Capacity, Storage, Overflow>& rhs) {
     return rhs < lhs;
 }
 
-template <typename T, size_t Capacity>
-bool operator>=(const vector<T, Capacity>& lhs, const vector<T, Capacity>& rhs) {
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+bool operator>=(const vector<T, Capacity, Storage, Overflow>& lhs, const vector<T, Capacity, Storage, Overflow>& rhs) {
     return !(lhs < rhs);
 }
 
-template <typename T, size_t Capacity>
-void swap(vector<T, Capacity>& lhs, vector<T, Capacity>& rhs) {
+template <typename T, size_t Capacity, typename Storage, typename Overflow>
+void swap(vector<T, Capacity, Storage, Overflow>& lhs, vector<T, Capacity, Storage, Overflow>& rhs) {
     lhs.swap(rhs);
 }
 